@@ -0,0 +1,87 @@
+//
+// Shared harness for argc_bench: synthetic workloads, heap accounting and reporting.
+//
+
+#ifndef ARGC_BENCH_HPP
+#define ARGC_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace argc_bench {
+
+    /// @brief A synthetic schema and command line.
+    /// @details Options are named opt-<i>. Every third option takes a value, every fourth also has an alias, the rest are
+    /// flags. Every schema also has two positionals (input, output) and a variadic positional (files). The command
+    /// line gives the positionals first, a quarter of its tokens as files, and spends the rest on options.
+    struct Workload {
+        std::size_t options = 0;
+        std::size_t tokens = 0;
+        std::vector<std::string> storage;
+        std::vector<const char*> argv;
+
+        static bool takes_value(const std::size_t i) { return i % 3 == 0; }
+        static bool has_alias(const std::size_t i) { return i % 4 == 0; }
+
+        Workload(const std::size_t options, const std::size_t tokens) : options(options), tokens(tokens) {
+            storage.reserve(tokens + 8);
+            storage.emplace_back("bench");
+            storage.emplace_back("input.txt");
+            storage.emplace_back("output.txt");
+
+            do {
+                storage.push_back("src/file-" + std::to_string(storage.size()) + ".cpp");
+            } while (storage.size() < 3 + tokens / 4);
+            for (std::size_t i = 0; storage.size() < tokens; i++) {
+                const std::size_t k = (i * 7919) % options;
+                storage.push_back((has_alias(k) && i % 2 ? "--alias-" : "--opt-") + std::to_string(k));
+                if (takes_value(k)) storage.push_back("value-" + std::to_string(k));
+            }
+
+            argv.reserve(storage.size());
+            for (const auto& s : storage) argv.push_back(s.c_str());
+        }
+    };
+
+    /// heap accounting, implemented by the replacement operator new in main.cpp
+    struct Heap {
+        static std::size_t allocations();
+        static std::size_t live_bytes();
+        static std::size_t peak_bytes();
+        /// restarts peak tracking from the current live size
+        static void reset_peak();
+    };
+
+    struct Measurement {
+        double build_us = 0;       // schema construction, once
+        double build_allocs = 0;
+        double ns_per_token = 0;   // steady state parse
+        double allocs_per_parse = 0;
+        std::size_t peak_bytes = 0; // heap high-water mark above the baseline, build and parse included
+    };
+
+    using clock = std::chrono::steady_clock;
+
+    inline double elapsed_ns(const clock::time_point since) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - since).count());
+    }
+
+    /// repeats parse until at least min_ns have passed, returning the number of runs
+    template <typename F>
+    std::size_t repeat(F&& parse, const double min_ns, double& total_ns) {
+        std::size_t runs = 0;
+        total_ns = 0;
+        while (runs == 0 || total_ns < min_ns) {
+            const auto start = clock::now();
+            parse();
+            total_ns += elapsed_ns(start);
+            runs++;
+        }
+        return runs;
+    }
+}
+
+#endif //ARGC_BENCH_HPP
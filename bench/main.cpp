@@ -0,0 +1,150 @@
+//
+// argc_bench: parse throughput, allocations and peak heap of the argc-- parser.
+//
+// usage: argc_bench [--quick] [--min-time MS]
+//
+// The policy-based argc++ engine is not measured: its parse loop does not parse yet, so its numbers would not be
+// comparable.
+//
+
+#include "bench.hpp"
+
+#include <single.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <span>
+
+// ---- heap accounting ----
+//
+// every allocation is preceded by its size and the address malloc returned, so live and peak bytes can be tracked
+// without a side table and plain and over-aligned blocks are freed the same way. pmr resources allocate through the
+// aligned overloads, so those are counted too.
+
+namespace {
+    struct Prefix {
+        void* block;
+        std::size_t size;
+    };
+
+    std::atomic<std::size_t> allocation_count{0};
+    std::atomic<std::size_t> live{0};
+    std::atomic<std::size_t> peak{0};
+
+    void* counted_alloc(const std::size_t size, const std::size_t alignment = alignof(std::max_align_t)) {
+        const std::size_t align = std::max(alignment, alignof(Prefix));
+        void* block = std::malloc(size + sizeof(Prefix) + align);
+        if (!block) throw std::bad_alloc();
+        const auto address = (reinterpret_cast<std::uintptr_t>(block) + sizeof(Prefix) + align - 1) & ~(align - 1);
+        static_cast<Prefix*>(reinterpret_cast<void*>(address))[-1] = {block, size};
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t now = live.fetch_add(size, std::memory_order_relaxed) + size;
+        std::size_t high = peak.load(std::memory_order_relaxed);
+        while (now > high && !peak.compare_exchange_weak(high, now, std::memory_order_relaxed)) {}
+        return reinterpret_cast<void*>(address);
+    }
+
+    void counted_free(void* ptr) noexcept {
+        if (!ptr) return;
+        const Prefix prefix = static_cast<Prefix*>(ptr)[-1];
+        live.fetch_sub(prefix.size, std::memory_order_relaxed);
+        std::free(prefix.block);
+    }
+}
+
+void* operator new(const std::size_t size) { return counted_alloc(size); }
+void* operator new[](const std::size_t size) { return counted_alloc(size); }
+void* operator new(const std::size_t size, const std::align_val_t align) { return counted_alloc(size, static_cast<std::size_t>(align)); }
+void* operator new[](const std::size_t size, const std::align_val_t align) { return counted_alloc(size, static_cast<std::size_t>(align)); }
+void operator delete(void* ptr) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { counted_free(ptr); }
+
+namespace argc_bench {
+    std::size_t Heap::allocations() { return allocation_count.load(std::memory_order_relaxed); }
+    std::size_t Heap::live_bytes() { return live.load(std::memory_order_relaxed); }
+    std::size_t Heap::peak_bytes() { return peak.load(std::memory_order_relaxed); }
+    void Heap::reset_peak() { peak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+    /// the arena-backed parser from src/argc--/single.hpp, reused across parses as recommended
+    Measurement bench_argc_minus(const Workload& workload, const double min_ns) {
+        Measurement m;
+        const std::size_t baseline = Heap::live_bytes();
+        Heap::reset_peak();
+
+        const std::size_t allocs_before = Heap::allocations();
+        const auto start = clock::now();
+        argcpp::Parser parser;
+        for (std::size_t i = 0; i < workload.options; i++) {
+            auto& arg = parser.add_argument("opt-" + std::to_string(i));
+            if (Workload::has_alias(i)) arg.aliases({"alias-" + std::to_string(i)});
+            if (Workload::takes_value(i)) arg.takes_value();
+        }
+        parser.add_argument("input").position(1);
+        parser.add_argument("output").position(2);
+        parser.add_argument("files").position(3).variadic();
+        parser.compile();
+        m.build_us = elapsed_ns(start) / 1000.0;
+        m.build_allocs = static_cast<double>(Heap::allocations() - allocs_before);
+
+        const std::span<const char* const> args(workload.argv);
+        parser.parse(args); // warm up: the first parse sizes the value lists
+        if (!parser.ok()) {
+            std::fprintf(stderr, "argc-- rejected the workload: %s\n", std::string(parser.result().error()).c_str());
+            std::exit(1);
+        }
+
+        double total_ns = 0;
+        const std::size_t parse_allocs_before = Heap::allocations();
+        const std::size_t runs = repeat([&] { parser.parse(args); }, min_ns, total_ns);
+        m.ns_per_token = total_ns / static_cast<double>(runs * workload.argv.size());
+        m.allocs_per_parse = static_cast<double>(Heap::allocations() - parse_allocs_before) / static_cast<double>(runs);
+        m.peak_bytes = Heap::peak_bytes() - baseline;
+        return m;
+    }
+
+    void report(const char* engine, const Workload& w, const Measurement& m) {
+        std::printf("%-7s %8zu %9zu %12.1f %12.0f %12.2f %14.2f %12zu\n",
+            engine, w.options, w.argv.size(), m.build_us, m.build_allocs, m.ns_per_token, m.allocs_per_parse, m.peak_bytes);
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv) {
+    using namespace argc_bench;
+
+    argcpp::Parser options(argc, argv);
+    options.add_argument("quick").short_name("q").help("small matrix, short runs");
+    options.add_argument("min-time").takes_value().help("minimum measured time per case in milliseconds");
+    options.parse();
+    if (!options.ok()) return 2;
+
+    const bool quick = options.provided("quick");
+    const double min_ns = options.get("min-time").get_or<double>(quick ? 20.0 : 200.0) * 1e6;
+
+    const std::vector<std::size_t> schema_sizes = quick
+        ? std::vector<std::size_t>{10, 1000}
+        : std::vector<std::size_t>{10, 100, 1000, 10000};
+    const std::vector<std::size_t> token_counts = quick
+        ? std::vector<std::size_t>{8, 1000, 100000}
+        : std::vector<std::size_t>{8, 100, 10000, 1000000};
+
+    std::printf("%-7s %8s %9s %12s %12s %12s %14s %12s\n",
+        "engine", "options", "tokens", "build_us", "build_alloc", "ns/token", "allocs/parse", "peak_bytes");
+    for (const std::size_t size : schema_sizes) {
+        for (const std::size_t tokens : token_counts) {
+            const Workload workload(size, tokens);
+            report("argc--", workload, bench_argc_minus(workload, min_ns));
+        }
+    }
+    return 0;
+}
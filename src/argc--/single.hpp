@@ -8,6 +8,65 @@
 #include <iostream>
 #include <exception>
 #include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <optional>
+#include <memory>
+#include <memory_resource>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <array>
+#include <bit>
+#include <span>
+#include <charconv>
+#include <system_error>
+#include <limits>
+#include <cmath>
+#include <utility>
+#include <tuple>
+#include <concepts>
+#include <fstream>
+#include <thread>
+#include <atomic>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+extern char** environ;
+#elif defined(_WIN32)
+#include <stdlib.h>
+#endif
+#include <cstdio>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ARGCPP_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARGCPP_SIMD_SSE2 1
+#endif
+#include <cstdlib>
+#include <cctype>
+#include <chrono>
+
+// ARGCPP_INSTRUMENT=1 records time, calls and allocations per parsing phase into argcpp::profile(). When it is 0 the
+// phase markers expand to nothing.
+#ifndef ARGCPP_INSTRUMENT
+#define ARGCPP_INSTRUMENT 0
+#endif
+#if ARGCPP_INSTRUMENT
+#define ARGCPP_PHASE(phase) const ::argcpp::helper::Phase_Scope argcpp_phase_scope_(::argcpp::Phase::phase)
+#else
+#define ARGCPP_PHASE(phase) static_cast<void>(0)
+#endif
 
 namespace argcpp::exceptions {
     class add_argument_error : public std::exception {
@@ -21,6 +80,16 @@ namespace argcpp::exceptions {
 
     };
 
+    class unknown_argument_error : public std::exception {
+        std::string msg_;
+    public:
+        explicit unknown_argument_error(const std::string& msg) : msg_(msg) {}
+
+        const char* what() const noexcept override {
+            return msg_.c_str();
+        }
+    };
+
     class push_back_and_replace_error : public std::exception {
         std::string msg_;
     public:
@@ -54,684 +123,4871 @@ namespace argcpp::helper {
             v.push_back(value);
         }
     }
-}
 
-namespace argcpp {
+    /// transparent hash so string keyed maps can be probed with a std::string_view without building a std::string
+    struct String_Hash {
+        using is_transparent = void;
+        std::size_t operator()(const std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
 
-    class Value;
-    struct Argument;
-    struct Positional;
-    class Parser;
+    /// @brief Calls at(pos) for every position of str that holds a or b, in increasing order.
+    /// @details Compares 32 bytes per step with AVX2, or 16 with SSE2, when the target is compiled for them, and visits
+    /// the set bits of each block's match mask, so dense and sparse matches both run close to memory bandwidth.
+    /// Other targets, the tail of str and constant evaluation use a plain loop.
+    template <typename F>
+    constexpr void for_each_byte(const std::string_view str, const char a, const char b, F&& at) {
+        std::size_t i = 0;
+        if (!std::is_constant_evaluated()) {
+#if defined(ARGCPP_SIMD_AVX2)
+            const __m256i va = _mm256_set1_epi8(a);
+            const __m256i vb = _mm256_set1_epi8(b);
+            for (; i + 32 <= str.size(); i += 32) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i));
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, va), _mm256_cmpeq_epi8(block, vb))));
+                for (; mask; mask &= mask - 1) at(i + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+#elif defined(ARGCPP_SIMD_SSE2)
+            const __m128i va = _mm_set1_epi8(a);
+            const __m128i vb = _mm_set1_epi8(b);
+            for (; i + 16 <= str.size(); i += 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i));
+                auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, va), _mm_cmpeq_epi8(block, vb))));
+                for (; mask; mask &= mask - 1) at(i + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+#endif
+        }
+        for (; i < str.size(); i++) {
+            if (str[i] == a || str[i] == b) at(i);
+        }
+    }
 
-    class Value {
-        bool is_set = false;
-        std::vector<Value> stored_values;
-        std::string stored_string;
-        bool stored_bool;
-        double stored_double;
-        int stored_int;
+    /// number of times c occurs in str
+    inline std::size_t count(const std::string_view str, const char c) noexcept {
+        std::size_t n = 0;
+        for_each_byte(str, c, c, [&n](std::size_t) { n++; });
+        return n;
+    }
 
-    public:
-        void reset() noexcept {
-            is_set = false;
-            stored_values.clear();
-            stored_string = "";
-            stored_bool = false;
-            stored_double = 0.0;
-            stored_int = 0;
+    /// calls each(piece) for every delimiter separated piece of str, the pieces are views into str
+    template <typename F>
+    constexpr void split(const std::string_view str, const char delimiter, F&& each) {
+        std::size_t begin = 0;
+        for_each_byte(str, delimiter, delimiter, [&](const std::size_t pos) {
+            each(str.substr(begin, pos - begin));
+            begin = pos + 1;
+        });
+        each(str.substr(begin));
+    }
+
+    /// @brief split() where escape followed by any character, a delimiter included, does not end a piece.
+    /// @details Calls each(piece, escaped) with a view into str; escaped tells whether the piece still contains escape
+    /// characters, see unescape().
+    template <typename F>
+    void split_escaped(const std::string_view str, const char delimiter, const char escape, F&& each) {
+        std::size_t begin = 0;
+        std::size_t skip = 0;
+        bool escaped = false;
+        for_each_byte(str, delimiter, escape, [&](const std::size_t pos) {
+            if (pos < skip) return;
+            if (str[pos] == escape) {
+                escaped = true;
+                skip = pos + 2;
+                return;
+            }
+            each(str.substr(begin, pos - begin), escaped);
+            begin = pos + 1;
+            escaped = false;
+        });
+        each(str.substr(begin), escaped);
+    }
+
+    /// piece without its escape characters, each of which stands for the character after it
+    inline std::pmr::string unescape(const std::string_view piece, const char escape,
+                                     std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        std::pmr::string out(resource);
+        out.reserve(piece.size());
+        for (std::size_t i = 0; i < piece.size(); i++) {
+            if (piece[i] == escape && i + 1 < piece.size()) i++;
+            out.push_back(piece[i]);
         }
+        return out;
+    }
 
-        explicit operator bool() const noexcept {
-            return stored_bool;
+    /// @brief Append-only pool with stable element addresses.
+    /// @details Elements live in chunks that double in size (16, 32, 64, ...), so n elements cost about log2(n / 16)
+    /// allocations and nothing is ever moved. References handed out by emplace_back() stay valid for the pool's lifetime.
+    template <typename T>
+    class Stable_Pool {
+        static constexpr std::size_t first_chunk = 16;
+
+        std::array<T*, 48> chunks_{};
+        std::size_t size_ = 0;
+
+        static constexpr std::size_t chunk_of(const std::size_t i) noexcept {
+            return std::bit_width(i / first_chunk + 1) - 1;
         }
 
-        explicit operator double() const noexcept {
-            return stored_double;
+        static constexpr std::size_t chunk_begin(const std::size_t chunk) noexcept {
+            return first_chunk * ((std::size_t{1} << chunk) - 1);
         }
 
-        explicit operator int() const noexcept {
-            return stored_int;
+    public:
+        class iterator {
+            Stable_Pool* pool_;
+            std::size_t i_;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            iterator(Stable_Pool* pool, const std::size_t i) : pool_(pool), i_(i) {}
+            T& operator*() const { return (*pool_)[i_]; }
+            T* operator->() const { return &(*pool_)[i_]; }
+            iterator& operator++() { i_++; return *this; }
+            iterator operator++(int) { iterator tmp = *this; i_++; return tmp; }
+            bool operator==(const iterator& other) const = default;
+        };
+
+        Stable_Pool() = default;
+        Stable_Pool(const Stable_Pool&) = delete;
+        Stable_Pool& operator=(const Stable_Pool&) = delete;
+
+        ~Stable_Pool() {
+            for (std::size_t i = 0; i < size_; i++) {
+                std::destroy_at(&(*this)[i]);
+            }
+            for (std::size_t c = 0; c < chunks_.size() && chunks_[c]; c++) {
+                std::allocator<T>().deallocate(chunks_[c], first_chunk << c);
+            }
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            const std::size_t c = chunk_of(size_);
+            if (!chunks_[c]) {
+                chunks_[c] = std::allocator<T>().allocate(first_chunk << c);
+            }
+            T* slot = chunks_[c] + (size_ - chunk_begin(c));
+            std::construct_at(slot, std::forward<Args>(args)...);
+            size_++;
+            return *slot;
         }
 
-        explicit operator std::string() const noexcept {
-            return stored_string;
+        T& operator[](const std::size_t i) noexcept {
+            const std::size_t c = chunk_of(i);
+            return chunks_[c][i - chunk_begin(c)];
         }
 
-        explicit operator std::vector<Value>() const noexcept {
-            return stored_values;
+        const T& operator[](const std::size_t i) const noexcept {
+            const std::size_t c = chunk_of(i);
+            return chunks_[c][i - chunk_begin(c)];
         }
 
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
 
-        Value& operator=(const std::string& s) {
-            reset();
-            stored_string = s;
-            is_set = true;
-            return *this;
+        iterator begin() { return {this, 0}; }
+        iterator end() { return {this, size_}; }
+    };
+
+    /// @brief Private, writable view of a whole file.
+    /// @details On POSIX systems the file is memory-mapped copy-on-write, so the parser can unquote tokens in place and
+    /// only the pages it actually rewrites are copied. Elsewhere the file is read into a heap buffer.
+    class Mapped_File {
+        char* data_ = nullptr;
+        std::size_t size_ = 0;
+        bool mapped_ = false;
+        bool ok_ = false;
+
+    public:
+        explicit Mapped_File(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            struct stat st{};
+            if (::fstat(fd, &st) == 0) {
+                size_ = static_cast<std::size_t>(st.st_size);
+                if (size_ == 0) {
+                    ok_ = true;
+                } else {
+                    void* p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                    if (p != MAP_FAILED) {
+                        ::madvise(p, size_, MADV_SEQUENTIAL);
+                        data_ = static_cast<char*>(p);
+                        mapped_ = true;
+                        ok_ = true;
+                    }
+                }
+            }
+            ::close(fd);
+#else
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (!in) return;
+            size_ = static_cast<std::size_t>(in.tellg());
+            data_ = size_ ? new char[size_] : nullptr;
+            in.seekg(0);
+            ok_ = static_cast<bool>(in.read(data_, static_cast<std::streamsize>(size_)));
+#endif
         }
 
-        Value& operator=(const int i) {
-            reset();
-            stored_int = i;
-            is_set = true;
+        Mapped_File(Mapped_File&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+              mapped_(std::exchange(other.mapped_, false)), ok_(std::exchange(other.ok_, false)) {}
+
+        Mapped_File(const Mapped_File&) = delete;
+        Mapped_File& operator=(const Mapped_File&) = delete;
+
+        Mapped_File& operator=(Mapped_File&& other) noexcept {
+            if (this != &other) {
+                release();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                mapped_ = std::exchange(other.mapped_, false);
+                ok_ = std::exchange(other.ok_, false);
+            }
             return *this;
         }
 
-        Value& operator=(const double d) {
-            reset();
-            stored_double = d;
-            is_set = true;
-            return *this;
+        ~Mapped_File() {
+            release();
         }
 
-        Value& operator=(const bool b) {
-            reset();
-            stored_bool = b;
-            is_set = true;
-            return *this;
+        void release() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+            if (mapped_) ::munmap(data_, size_);
+#else
+            delete[] data_;
+#endif
+            data_ = nullptr;
+            size_ = 0;
+            mapped_ = false;
+            ok_ = false;
         }
 
-        Value& operator=(const char* s) {
-            reset();
-            stored_string = s;
-            is_set = true;
-            return *this;
+        [[nodiscard]] bool ok() const noexcept { return ok_; }
+        [[nodiscard]] char* data() const noexcept { return data_; }
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    };
+
+    /// @brief Reads the next token of a response file and advances pos past it.
+    /// @details Tokens are separated by whitespace. Single and double quotes group characters, and a backslash escapes
+    /// the next character outside single quotes. Quotes and escapes are removed by compacting the token in place,
+    /// which only writes to memory when the token actually contains one.
+    /// @return false when only whitespace remains
+    inline bool next_response_token(char*& pos, char* const end, std::string_view& token) {
+        const auto is_space = [](const char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; };
+        while (pos != end && is_space(*pos)) pos++;
+        if (pos == end) return false;
+
+        char* const begin = pos;
+        char* out = pos;
+        char quote = 0;
+        for (; pos != end; pos++) {
+            const char c = *pos;
+            if (quote) {
+                if (c == quote) { quote = 0; continue; }
+                if (c == '\\' && quote == '"' && pos + 1 != end) pos++;
+            } else {
+                if (is_space(c)) break;
+                if (c == '"' || c == '\'') { quote = c; continue; }
+                if (c == '\\' && pos + 1 != end) pos++;
+            }
+            if (out != pos) *out = *pos;
+            out++;
         }
+        token = std::string_view(begin, static_cast<std::size_t>(out - begin));
+        return true;
+    }
 
-        Value& operator=(const std::vector<Value> &v) {
-            reset();
-            stored_values = v;
-            is_set = true;
-            return *this;
+    /// columns of the terminal on stdout, or fallback when stdout is not a terminal
+    inline std::size_t terminal_width(const std::size_t fallback = 80) noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+        winsize ws{};
+        if (::isatty(STDOUT_FILENO) && ::ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0) return ws.ws_col;
+#endif
+        return fallback;
+    }
+
+    /// whether a textual switch (from the environment or a config file) turns a flag on
+    constexpr bool is_truthy(const std::string_view v) noexcept {
+        return v == "1" || v == "true" || v == "TRUE" || v == "True" || v == "yes" || v == "on";
+    }
+
+    /// @brief Calls each(key, value) for every key = value line of one section of an INI/TOML-like file.
+    /// @details section names the [section] to read; an empty name reads the lines before the first header. Lines
+    /// outside the section are never parsed: other sections are skipped by searching for the next line that starts
+    /// with '[', and the scan stops where the section ends. Blank lines and lines starting with '#' or ';' are
+    /// comments, an unquoted value ends at " #", and quoted values are unquoted in place (backslash escapes work in
+    /// double quotes). Keys and values are views into [begin, end).
+    template <typename F>
+    void scan_config(char* const begin, char* const end, const std::string_view section, F&& each) {
+        const auto trim = [](std::string_view v) {
+            while (!v.empty() && (v.front() == ' ' || v.front() == '\t')) v.remove_prefix(1);
+            while (!v.empty() && (v.back() == ' ' || v.back() == '\t' || v.back() == '\r')) v.remove_suffix(1);
+            return v;
+        };
+        const std::string_view text(begin, static_cast<std::size_t>(end - begin));
+
+        std::size_t pos = 0;
+        bool inside = section.empty();
+        if (!inside) {
+            // find the header, looking only at line starts that open a header
+            for (;;) {
+                const std::size_t line_end = std::min(text.find('\n', pos), text.size());
+                const std::string_view line = trim(text.substr(pos, line_end - pos));
+                if (line.size() > 2 && line.front() == '[' && line.back() == ']' && trim(line.substr(1, line.size() - 2)) == section) {
+                    pos = line_end;
+                    break;
+                }
+                const std::size_t next = text.find("\n[", line_end == text.size() ? text.size() : line_end);
+                if (next == std::string_view::npos) return;
+                pos = next + 1;
+            }
         }
 
+        while (pos < text.size()) {
+            const std::size_t line_end = std::min(text.find('\n', pos), text.size());
+            const std::string_view line = trim(text.substr(pos, line_end - pos));
+            pos = line_end + 1;
+            if (line.empty() || line.front() == '#' || line.front() == ';') continue;
+            if (line.front() == '[') return; // the section is over
+
+            const std::size_t eq = line.find('=');
+            if (eq == std::string_view::npos) continue;
+            const std::string_view key = trim(line.substr(0, eq));
+            std::string_view value = trim(line.substr(eq + 1));
+
+            if (!value.empty() && (value.front() == '"' || value.front() == '\'')) {
+                const char quote = value.front();
+                char* in = begin + (value.data() - text.data()) + 1;
+                char* const stop = begin + (value.data() + value.size() - text.data());
+                char* const first = in;
+                char* out = in;
+                for (; in != stop && *in != quote; in++) {
+                    if (*in == '\\' && quote == '"' && in + 1 != stop) in++;
+                    *out++ = *in;
+                }
+                value = std::string_view(first, static_cast<std::size_t>(out - first));
+            } else if (const std::size_t comment = value.find(" #"); comment != std::string_view::npos) {
+                value = trim(value.substr(0, comment));
+            }
+            each(key, value);
+        }
+    }
 
+    /// the process environment as NAME=VALUE strings, terminated by a null pointer
+    inline const char* const* environment() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+        return environ;
+#elif defined(_WIN32)
+        return _environ;
+#else
+        return nullptr;
+#endif
+    }
 
-    };
+    /// @brief Writes pieces back to back to stdout or stderr.
+    /// @details On POSIX systems this is a single writev() (repeated only if the kernel accepts a partial write), so a
+    /// large help text reaches the terminal in one system call and is never interleaved with other output.
+    inline void write_out(const bool to_stderr, const std::initializer_list<std::string_view> pieces) {
+#if defined(__unix__) || defined(__APPLE__)
+        std::array<iovec, 8> iov{};
+        std::size_t count = 0;
+        for (const auto piece : pieces) {
+            if (!piece.empty() && count < iov.size()) iov[count++] = {const_cast<char*>(piece.data()), piece.size()};
+        }
+        std::fflush(to_stderr ? stderr : stdout);
+        const int fd = to_stderr ? STDERR_FILENO : STDOUT_FILENO;
+        iovec* next = iov.data();
+        while (count > 0) {
+            ssize_t written = ::writev(fd, next, static_cast<int>(count));
+            if (written < 0) return;
+            while (count > 0 && static_cast<std::size_t>(written) >= next->iov_len) {
+                written -= static_cast<ssize_t>(next->iov_len);
+                next++;
+                count--;
+            }
+            if (count > 0) {
+                next->iov_base = static_cast<char*>(next->iov_base) + written;
+                next->iov_len -= static_cast<std::size_t>(written);
+            }
+        }
+#else
+        std::FILE* out = to_stderr ? stderr : stdout;
+        for (const auto piece : pieces) std::fwrite(piece.data(), 1, piece.size(), out);
+        std::fflush(out);
+#endif
+    }
 
-    struct Argument {
-    private:
-        Parser* parser_ = nullptr; // back-reference to the parser
+    /// @brief Appends text to out, word wrapped so no line passes width columns.
+    /// @details The text continues on the current line, which is already column characters long, and every further
+    /// line is indented by indent spaces. Newlines in text are kept. A word longer than a whole line is not broken.
+    /// out is a std::string or anything with the same push_back() and append() members, which lets compile-time
+    /// schemas lay out their help with the same code.
+    template <typename Out>
+    constexpr void append_wrapped(Out& out, const std::string_view text, std::size_t column, const std::size_t indent, const std::size_t width) {
+        bool line_start = true;
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            if (text[pos] == '\n') {
+                out.push_back('\n');
+                out.append(indent, ' ');
+                column = indent;
+                line_start = true;
+                pos++;
+                continue;
+            }
+            if (text[pos] == ' ') { pos++; continue; }
+
+            std::size_t end = pos;
+            while (end < text.size() && text[end] != ' ' && text[end] != '\n') end++;
+            const std::size_t length = end - pos;
+            if (!line_start && column + 1 + length > width) {
+                out.push_back('\n');
+                out.append(indent, ' ');
+                column = indent;
+                line_start = true;
+            }
+            if (!line_start) {
+                out.push_back(' ');
+                column++;
+            }
+            out.append(text.substr(pos, length));
+            column += length;
+            line_start = false;
+            pos = end;
+        }
+    }
 
+    /// @brief Runs body(index, worker) for every index in [0, n) on a fixed set of threads.
+    /// @details Every worker starts with an equal contiguous share of the indices and takes them from its front in small
+    /// chunks. A worker that runs dry steals the back half of another worker's share, so uneven costs still balance.
+    /// Each share is one packed atomic (begin, end), so taking and stealing are a single compare-exchange each.
+    /// worker is in [0, threads) and lets body keep per-thread scratch. The first exception thrown by body is rethrown.
+    template <typename F>
+    void parallel_for(const std::size_t n, unsigned threads, F&& body) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(n, 1)));
+        if (threads == 1) {
+            for (std::size_t i = 0; i < n; i++) body(i, 0u);
+            return;
+        }
 
-        /// @brief Primary identifier for the argument in its extended form.
-        /// @details Examples: "help", "output", "verbose".
-        std::string _canonical_name;
+        constexpr std::uint64_t chunk = 8;
+        const auto pack = [](const std::uint64_t begin, const std::uint64_t end) { return begin << 32 | end; };
+        const auto begin_of = [](const std::uint64_t share) { return share >> 32; };
+        const auto end_of = [](const std::uint64_t share) { return share & 0xFFFFFFFFu; };
 
-        /// @brief Additional long-form identifiers that resolve to this argument.
-        /// @details Useful for maintaining backwards compatibility or providing intuitive alternatives.
-        std::vector<std::string> _aliases;
+        std::vector<std::atomic<std::uint64_t>> shares(threads);
+        for (unsigned w = 0; w < threads; w++) {
+            shares[w].store(pack(n * w / threads, n * (w + 1) / threads), std::memory_order_relaxed);
+        }
 
-        /// @brief Human-readable explanation of the argument's purpose and behavior.
-        /// @details Displayed in help text and documentation.
-        std::string _description;
+        std::exception_ptr error;
+        std::atomic<bool> has_error = false;
+
+        const auto work = [&](const unsigned self) {
+            try {
+                for (;;) {
+                    // drain our own share from the front
+                    std::uint64_t share = shares[self].load(std::memory_order_acquire);
+                    while (begin_of(share) < end_of(share)) {
+                        const std::uint64_t b = begin_of(share);
+                        const std::uint64_t e = std::min(end_of(share), b + chunk);
+                        if (shares[self].compare_exchange_weak(share, pack(e, end_of(share)), std::memory_order_acq_rel)) {
+                            for (std::uint64_t i = b; i < e; i++) body(static_cast<std::size_t>(i), self);
+                            share = shares[self].load(std::memory_order_acquire);
+                        }
+                    }
+                    if (has_error.load(std::memory_order_relaxed)) return;
+
+                    // steal the back half of someone else's share, a single remaining index is left to its owner
+                    bool stole = false;
+                    for (unsigned k = 1; k < threads && !stole; k++) {
+                        const unsigned victim = (self + k) % threads;
+                        std::uint64_t other = shares[victim].load(std::memory_order_acquire);
+                        while (end_of(other) - std::min(end_of(other), begin_of(other)) >= 2) {
+                            const std::uint64_t b = begin_of(other);
+                            const std::uint64_t mid = b + (end_of(other) - b) / 2;
+                            if (shares[victim].compare_exchange_weak(other, pack(b, mid), std::memory_order_acq_rel)) {
+                                shares[self].store(pack(mid, end_of(other)), std::memory_order_release);
+                                stole = true;
+                                break;
+                            }
+                        }
+                    }
+                    if (!stole) return;
+                }
+            } catch (...) {
+                if (!has_error.exchange(true)) error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned w = 1; w < threads; w++) pool.emplace_back(work, w);
+        work(0);
+        for (auto& t : pool) t.join();
+        if (error) std::rethrow_exception(error);
+    }
 
-        /// @brief Metavariable name shown in usage examples.
-        /// @details Typically uppercase (FILE, NUMBER, PATH) to distinguish from literal values.
-        std::string _value_name;
+    /// @brief Levenshtein distance from one pattern to many texts, with Hyyrö's bit-parallel form of Myers' algorithm.
+    /// @details The pattern's character positions are kept as bit masks, so each text character updates a whole column
+    /// of the edit-distance matrix with a few word operations. A text therefore costs O(length) with a tiny constant,
+    /// which keeps ranking a few thousand names well under a millisecond. Patterns longer than 64 characters are not
+    /// supported and report no matches.
+    class Edit_Distance {
+        std::array<std::uint64_t, 256> peq_{}; // bit i of peq_[c] is set when pattern[i] == c
+        std::size_t length_ = 0;
 
-        /// @brief Organizational label for grouping related arguments in help output.
-        /// @details Examples: "Input Options", "Network Configuration". By default it falls under a general, unnamed category.
-        std::string _category;
+    public:
+        explicit Edit_Distance(const std::string_view pattern) : length_(pattern.size()) {
+            if (length_ > 64) return;
+            for (std::size_t i = 0; i < length_; i++) {
+                peq_[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << i;
+            }
+        }
 
-        /// @brief Indicates whether the argument expects an associated value.
-        /// @details Mutually exclusive with is_flag in most scenarios.
-        bool _takes_value = false;
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        /// @brief Edit distance between the pattern and text, or npos once it is certain to exceed limit.
+        [[nodiscard]] std::size_t operator()(const std::string_view text, const std::size_t limit) const noexcept {
+            if (length_ > 64) return npos;
+            if (length_ == 0) return text.size() <= limit ? text.size() : npos;
+            const std::size_t gap = text.size() > length_ ? text.size() - length_ : length_ - text.size();
+            if (gap > limit) return npos;
+
+            const std::uint64_t last = std::uint64_t{1} << (length_ - 1);
+            std::uint64_t pv = ~std::uint64_t{0};
+            std::uint64_t mv = 0;
+            std::size_t score = length_;
+            for (std::size_t i = 0; i < text.size(); i++) {
+                const std::uint64_t eq = peq_[static_cast<unsigned char>(text[i])];
+                const std::uint64_t xv = eq | mv;
+                const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                std::uint64_t ph = mv | ~(xh | pv);
+                std::uint64_t mh = pv & xh;
+                if (ph & last) score++;
+                else if (mh & last) score--;
+                // the first row of the matrix is 0, 1, 2, ..., so a +1 enters from the top
+                ph = (ph << 1) | 1;
+                mh <<= 1;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+                // every remaining character can lower the score by at most one
+                if (score > limit + (text.size() - i - 1)) return npos;
+            }
+            return score <= limit ? score : npos;
+        }
+    };
 
-        /// @brief Marks the argument as a boolean switch with no associated value.
-        /// @details Presence indicates true, absence indicates false. By default arguments are flags, meaning _min and _max_values are by default set to 0
-        bool _is_flag = true;
+    /// FNV-1a over the bytes of a name, seeded so that the same key can be sent to a different slot
+    /// for every displacement the perfect hash tries, finished with murmur3's avalanche step.
+    constexpr std::uint32_t hash(const std::string_view key, const std::uint32_t seed) noexcept {
+        std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (const char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
 
-        /// @brief Enforces that the argument must be present for valid invocation.
-        /// @details Parser will fail if this argument is missing.
-        bool _required = false;
+    /// @brief Immutable perfect hash table from names to dense indices.
+    /// @details Built once with hash-and-displace: keys are spread into buckets by a first hash, then buckets are
+    /// placed largest first by searching for a seed that sends every key of the bucket to a free slot. A lookup is two
+    /// hashes, a single probe and one key comparison, and never allocates. Keys are copied into one contiguous blob so
+    /// the table does not depend on the lifetime of the strings it was built from.
+    class Perfect_Hash {
+    public:
+        static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
 
-        /// @brief Fallback value used when the argument is not explicitly provided.
-        /// @details Value::empty is a flag for if _default_value is empty
-        Value _default_value;
+    private:
+        struct Slot {
+            std::uint32_t offset = 0;
+            std::uint32_t length = 0;
+            std::uint32_t value = npos;
+        };
 
-        /// @brief Stores the actual value supplied by the user during parsing.
-        /// @details Remains empty if the argument was not provided.
-        Value _value;
+        std::vector<std::uint32_t> seeds_;
+        std::vector<Slot> slots_;
+        std::string keys_;
 
-        /// @brief Collection of values for arguments that accept multiple inputs.
-        /// @details Used when min_values/max_values allow more than one value.
-        std::vector<Value> _values;
+    public:
+        Perfect_Hash() = default;
+
+        /// @param entries (key, value) pairs, keys must be unique
+        explicit Perfect_Hash(const std::vector<std::pair<std::string_view, std::uint32_t>>& entries) {
+            if (entries.empty()) return;
+
+            const std::size_t n = entries.size();
+            // ~4 keys per bucket and a 0.8 load factor keep the seed search short even for thousands of names
+            const std::size_t bucket_count = n / 4 + 1;
+            std::size_t slot_count = n + n / 4 + 1;
+
+            // counting sort the entries by bucket, so bucket b is members[begin[b], begin[b + 1])
+            std::vector<std::uint32_t> begin(bucket_count + 1, 0);
+            std::vector<std::uint32_t> bucket_of(n);
+            for (std::uint32_t i = 0; i < n; i++) {
+                bucket_of[i] = hash(entries[i].first, 0) % bucket_count;
+                begin[bucket_of[i] + 1]++;
+            }
+            std::partial_sum(begin.begin(), begin.end(), begin.begin());
+            std::vector<std::uint32_t> members(n);
+            {
+                std::vector<std::uint32_t> fill(begin.begin(), begin.end() - 1);
+                for (std::uint32_t i = 0; i < n; i++) members[fill[bucket_of[i]]++] = i;
+            }
+            const auto bucket_size = [&](const std::uint32_t b) { return begin[b + 1] - begin[b]; };
+
+            std::vector<std::uint32_t> order(bucket_count);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](const std::uint32_t a, const std::uint32_t b) {
+                return bucket_size(a) > bucket_size(b);
+            });
+
+            std::vector<std::size_t> placed;
+            for (;;) {
+                seeds_.assign(bucket_count, 0);
+                slots_.assign(slot_count, Slot{});
+                std::vector<bool> taken(slot_count, false);
+                bool failed = false;
+
+                for (const std::uint32_t b : order) {
+                    if (bucket_size(b) == 0) break;
+                    const std::uint32_t* bucket = members.data() + begin[b];
+                    const std::uint32_t size = bucket_size(b);
+
+                    std::uint32_t seed = 1;
+                    for (; seed < (1u << 16); seed++) {
+                        placed.clear();
+                        bool fits = true;
+                        for (std::uint32_t k = 0; k < size; k++) {
+                            const std::size_t slot = hash(entries[bucket[k]].first, seed) % slot_count;
+                            if (taken[slot] || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                                fits = false;
+                                break;
+                            }
+                            placed.push_back(slot);
+                        }
+                        if (fits) break;
+                    }
+                    if (seed == (1u << 16)) { failed = true; break; }
+
+                    seeds_[b] = seed;
+                    for (std::uint32_t k = 0; k < size; k++) {
+                        taken[placed[k]] = true;
+                        slots_[placed[k]].value = entries[bucket[k]].second;
+                        slots_[placed[k]].offset = bucket[k];
+                    }
+                }
 
-        /// @brief Lower bound on the number of values this argument can accept.
-        // if the argument is a flag both _max_values and _min_values would be 0
-        int _min_values = 0;
+                if (!failed) break;
+                // practically unreachable, but a larger table always makes room
+                slot_count += slot_count / 2 + 1;
+            }
 
-        /// @brief Upper bound on the number of values this argument can accept.
-        /// @details Use -1 to allow unlimited values. This means all arguments after this argument would be its values.
-        int _max_values = 0;
+            // the offset field temporarily held the entry index, replace it with the key's position in the blob
+            std::size_t total = 0;
+            for (const auto& [key, value] : entries) total += key.size();
+            keys_.reserve(total);
+            for (auto& slot : slots_) {
+                if (slot.value == npos) continue;
+                const std::string_view key = entries[slot.offset].first;
+                slot.offset = static_cast<std::uint32_t>(keys_.size());
+                slot.length = static_cast<std::uint32_t>(key.size());
+                keys_.append(key);
+            }
+        }
 
-        /// @brief Restricts input to a predefined set of acceptable values.
-        /// @details Parser rejects values not present in this list.
-        std::vector<std::string> _allowed_values;
+        /// @return value stored for key, npos when the key was never inserted
+        [[nodiscard]] std::uint32_t find(const std::string_view key) const noexcept {
+            if (slots_.empty()) return npos;
+            const std::uint32_t seed = seeds_[hash(key, 0) % seeds_.size()];
+            const Slot& slot = slots_[hash(key, seed) % slots_.size()];
+            if (slot.value == npos || std::string_view(keys_).substr(slot.offset, slot.length) != key) {
+                return npos;
+            }
+            return slot.value;
+        }
 
-        /// @brief Custom predicate for complex validation logic.
-        /// @details Return true if the value meets requirements, false otherwise.
-        std::function<bool(const std::string&)> _validator;
+        [[nodiscard]] bool empty() const noexcept {
+            return slots_.empty();
+        }
+    };
 
-        /// @brief Message displayed when validation fails.
-        /// @details Provides context-specific guidance to the user.
-        std::string _validation_error;
+    constexpr char fold(const char c) noexcept {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
 
-        /// @brief Arguments that cannot be used simultaneously with this one.
-        /// @details Parser fails if any conflicting arguments are present together.
-        std::vector<std::string> _conflicts_with;
+    /// @brief Set of allowed values for one argument, mapping a value to the index of the choice it matches.
+    /// @details The choices go into a Perfect_Hash when the schema is compiled, so checking a value is one probe no
+    /// matter how many choices there are. Case insensitive sets store their keys folded to lower case, and a value is
+    /// folded once into a stack buffer before the probe. Folding is ASCII only.
+    class Choice_Set {
+        Perfect_Hash table_;
+        std::vector<std::string> choices_; // as declared, for error messages
+        std::size_t longest_ = 0;
+        bool case_sensitive_ = true;
 
-        /// @brief Arguments that must be present if this argument is used.
-        /// @details Enforces dependencies between related options.
-        std::vector<std::string> _mandated;
+    public:
+        Choice_Set() = default;
+
+        Choice_Set(const std::vector<std::string>& choices, const bool case_sensitive)
+            : choices_(choices), case_sensitive_(case_sensitive) {
+            std::vector<std::string> folded;
+            if (!case_sensitive) {
+                folded.reserve(choices.size());
+                for (const auto& choice : choices) {
+                    std::string& key = folded.emplace_back(choice);
+                    std::transform(key.begin(), key.end(), key.begin(), fold);
+                }
+            }
+            const std::vector<std::string>& keys = case_sensitive ? choices : folded;
+
+            // a choice listed twice (or twice up to case) keeps the index of its first occurrence
+            std::vector<std::pair<std::string_view, std::uint32_t>> entries;
+            entries.reserve(keys.size());
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                entries.emplace_back(keys[i], static_cast<std::uint32_t>(i));
+                longest_ = std::max(longest_, keys[i].size());
+            }
+            std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            entries.erase(std::unique(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), entries.end());
+            table_ = Perfect_Hash(entries);
+        }
 
-        /// @brief At least one argument from this list must be present if this argument is used.
-        /// @details Implements "requires any of" dependency semantics.
-        std::vector<std::string> _requires_one_of;
+        /// @return index of the choice value matches, npos if it matches none
+        [[nodiscard]] std::uint32_t find(const std::string_view value) const noexcept {
+            if (value.size() > longest_) return Perfect_Hash::npos;
+            if (case_sensitive_) return table_.find(value);
 
-        /// @brief Tracks whether the user explicitly provided this argument.
-        /// @details Distinguishes between default values and user-supplied values.
-        bool _was_provided = false;
+            std::array<char, 256> buffer;
+            if (value.size() <= buffer.size()) {
+                std::transform(value.begin(), value.end(), buffer.begin(), fold);
+                return table_.find({buffer.data(), value.size()});
+            }
+            std::string key(value);
+            std::transform(key.begin(), key.end(), key.begin(), fold);
+            return table_.find(key);
+        }
 
-        /// @brief Index for positional arguments that don't use flag syntax.
-        /// @details Zero indicates this is not a positional argument.
-        int _position = 0;
+        [[nodiscard]] const std::vector<std::string>& choices() const noexcept {
+            return choices_;
+        }
+    };
 
-        /// @brief Whether argument is positional
-        /// @details implies _position is > 0
-        bool _is_positional = false;
+    /// @brief Immutable character trie from words to dense indices.
+    /// @details Built once from the full word list: the children of every node are stored next to each other in
+    /// character order, so a lookup walks one short, contiguous run of nodes per character and never allocates. Unlike
+    /// a hash it can also enumerate every word under a prefix, which completion uses.
+    class Trie {
+    public:
+        static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
 
-        /// @brief Excludes the argument from generated help text.
-        /// @details Typically used for deprecated or internal-only options.
-        bool _hidden = false;
+    private:
+        struct Node {
+            std::uint32_t first = 0; // children are nodes_[first, last)
+            std::uint32_t last = 0;
+            std::uint32_t value = npos;
+            char c = 0;
+        };
+        std::vector<Node> nodes_;
+        std::vector<std::string> words_; // by value, to rebuild words while enumerating
+
+        /// node reached by following prefix from the root, npos if no word starts with prefix
+        [[nodiscard]] std::uint32_t walk(const std::string_view prefix) const noexcept {
+            if (nodes_.empty()) return npos;
+            std::uint32_t node = 0;
+            for (const char c : prefix) {
+                const Node& n = nodes_[node];
+                std::uint32_t next = npos;
+                for (std::uint32_t i = n.first; i < n.last; i++) {
+                    if (nodes_[i].c == c) { next = i; break; }
+                }
+                if (next == npos) return npos;
+                node = next;
+            }
+            return node;
+        }
 
-        /// @brief Marks the argument as outdated but still functional.
-        /// @details Parser may emit a warning when deprecated arguments are used.
-        bool _deprecated = false;
+    public:
+        Trie() = default;
+
+        /// @param words unique words, a word's index in the list is its value
+        explicit Trie(std::vector<std::string> words) : words_(std::move(words)) {
+            if (words_.empty()) return;
+            std::vector<std::uint32_t> order(words_.size());
+            std::iota(order.begin(), order.end(), 0u);
+            std::sort(order.begin(), order.end(), [this](const std::uint32_t a, const std::uint32_t b) { return words_[a] < words_[b]; });
+
+            // breadth first, so every node's children are appended as one contiguous run
+            struct Pending {
+                std::uint32_t node;
+                std::size_t begin;
+                std::size_t end;
+                std::size_t depth;
+            };
+            std::vector<Pending> queue{{0, 0, order.size(), 0}};
+            nodes_.emplace_back();
+            for (std::size_t q = 0; q < queue.size(); q++) {
+                const Pending p = queue[q];
+                std::size_t i = p.begin;
+                if (i < p.end && words_[order[i]].size() == p.depth) nodes_[p.node].value = order[i++];
+                nodes_[p.node].first = static_cast<std::uint32_t>(nodes_.size());
+                while (i < p.end) {
+                    const char c = words_[order[i]][p.depth];
+                    std::size_t j = i;
+                    while (j < p.end && words_[order[j]][p.depth] == c) j++;
+                    const auto child = static_cast<std::uint32_t>(nodes_.size());
+                    nodes_.push_back({0, 0, npos, c});
+                    queue.push_back({child, i, j, p.depth + 1});
+                    i = j;
+                }
+                nodes_[p.node].last = static_cast<std::uint32_t>(nodes_.size());
+            }
+        }
 
-        /// @brief Informational message shown when a deprecated argument is encountered.
-        /// @details Should guide users toward the recommended alternative.
-        std::string _deprecated_message;
+        /// @return value of word, npos when it was never inserted
+        [[nodiscard]] std::uint32_t find(const std::string_view word) const noexcept {
+            const std::uint32_t node = walk(word);
+            return node == npos ? npos : nodes_[node].value;
+        }
 
-        /// @brief Character used to split a single value string into multiple values.
-        /// @details Common choices: ',' for lists, ':' for paths.
-        char _value_delimiter = ',';
+        /// calls each(word, value) for every word that starts with prefix, in order
+        template <typename F>
+        void for_each_prefixed(const std::string_view prefix, F&& each) const {
+            const std::uint32_t start = walk(prefix);
+            if (start == npos) return;
+            std::vector<std::uint32_t> stack{start};
+            while (!stack.empty()) {
+                const Node& n = nodes_[stack.back()];
+                stack.pop_back();
+                if (n.value != npos) each(std::string_view(words_[n.value]), n.value);
+                for (std::uint32_t i = n.last; i > n.first; i--) stack.push_back(i - 1);
+            }
+        }
 
-        /// @brief Controls whether value matching respects character case.
-        /// @details Affects both allowed_values checking and general comparison.
-        bool _case_sensitive = true;
+        [[nodiscard]] bool empty() const noexcept {
+            return nodes_.empty();
+        }
+    };
+}
 
-        /// @brief Permits values beginning with a hyphen character.
-        /// @details Necessary for negative numbers and certain edge cases.
-        bool _allow_hyphen_values = false;
+namespace argcpp {
 
-        /// @brief Environment variable consulted when the argument is not provided.
-        /// @details Offers a secondary source for configuration values.
-        std::string _env_var;
+    /// @brief Stages of compiling and parsing that instrumentation tells apart, see Profile.
+    enum class Phase : std::uint8_t {
+        compile,     // Parser::compile(), including the phases below it
+        parse,       // one parse, including the phases below it
+        tokenize,    // pulling tokens from argv and response files
+        lookup,      // resolving option and subcommand names
+        split,       // splitting and storing values
+        validate,    // allowed value checks
+        environment, // environment snapshot and fallbacks
+        config,      // config file scanning and fallbacks
+        constraints, // required arguments and constraint checks
+        bind,        // writing bound variables and option structs
+        help,        // rendering help text
+    };
 
-        // allow for "attribute-chaining"
+    inline constexpr std::size_t phase_count = 11;
+
+    inline constexpr std::array<std::string_view, phase_count> phase_names{
+        "compile", "parse", "tokenize", "lookup", "split", "validate", "environment", "config", "constraints", "bind", "help",
+    };
+
+    /// @brief Time, calls and allocations per Phase, recorded when the header is compiled with ARGCPP_INSTRUMENT=1.
+    /// @details Each thread records into its own profile, see profile(), so parse_batch workers never contend. Phases
+    /// nest (lookups happen during a parse), so durations are inclusive. Allocations are only counted when exactly one
+    /// translation unit defines ARGCPP_INSTRUMENT_ALLOCATIONS before including this header, which replaces the global
+    /// operator new with one that counts into the calling thread's profile.
+    class Profile {
     public:
-        /// @brief Sets the primary long-form name of the argument.
-        /// @details Corresponds to the user-facing identifier used as --name.
-        Argument& long_name(const std::string &long_name) {
-            this->_canonical_name = long_name;
-            this->_value_name = long_name;
-            return *this;
+        struct Totals {
+            std::uint64_t nanoseconds = 0;
+            std::uint64_t calls = 0;
+            std::uint64_t allocations = 0;
+            std::uint64_t bytes = 0;
+        };
+
+        /// one timed phase, in nanoseconds since the profile was created or cleared
+        struct Event {
+            Phase phase;
+            std::uint64_t start;
+            std::uint64_t duration;
+        };
+
+        // events beyond this are only added to the totals, so tight loops cannot grow the trace without bound
+        static constexpr std::size_t max_events = std::size_t{1} << 16;
+
+        // running allocation counters, fed by the counting operator new
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+
+    private:
+        std::array<Totals, phase_count> totals_{};
+        std::vector<Event> events_;
+        std::chrono::steady_clock::time_point origin_ = std::chrono::steady_clock::now();
+        std::uint32_t thread_;
+
+        static std::uint32_t next_thread() noexcept {
+            static std::atomic<std::uint32_t> threads{0};
+            return ++threads;
         }
 
-        /// @brief Sets the short-form name of the argument.
-        /// @details Typically a single character used with a single hyphen (e.g., -v).
-        Argument& short_name(const std::string &short_name);
+        static void append_number(std::string& out, const char* format, const double value) {
+            char buffer[32];
+            const int n = std::snprintf(buffer, sizeof(buffer), format, value);
+            out.append(buffer, static_cast<std::size_t>(std::max(n, 0)));
+        }
 
-        /// @brief Replaces the alias list with new alternative long-form identifiers.
-        /// @details Aliases allow multiple names to refer to the same argument.
-        Argument& aliases(const std::vector<std::string> &alias_list);
+    public:
+        Profile() : thread_(next_thread()) {}
 
-        /// @brief Sets the argument's description.
-        /// @details Shown in generated help and documentation.
-        Argument& help(const std::string &description) {
-            this->_description = description;
-            return *this;
+        [[nodiscard]] const Totals& operator[](const Phase phase) const noexcept {
+            return totals_[static_cast<std::size_t>(phase)];
         }
 
-        /// @brief Assigns the metavariable name used when displaying usage examples.
-        /// @details Helps visually distinguish user-supplied values from literal tokens.
-        Argument& value_name(const std::string &value_name) {
-            this->_value_name = value_name;
-            return *this;
+        [[nodiscard]] std::span<const Event> events() const noexcept {
+            return events_;
         }
 
-        /// @brief Groups this argument under a named help section.
+        [[nodiscard]] std::chrono::steady_clock::time_point origin() const noexcept {
+            return origin_;
+        }
+
+        /// adds one timed phase; allocations and bytes are what the phase allocated
+        void record(const Phase phase, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end,
+                    const std::uint64_t allocated, const std::uint64_t allocated_bytes) {
+            const auto ns = [](const auto d) { return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()); };
+            Totals& t = totals_[static_cast<std::size_t>(phase)];
+            t.nanoseconds += ns(end - start);
+            t.calls++;
+            t.allocations += allocated;
+            t.bytes += allocated_bytes;
+            if (events_.size() < max_events) events_.push_back({phase, ns(start - origin_), ns(end - start)});
+        }
+
+        void clear() noexcept {
+            totals_ = {};
+            events_.clear();
+            origin_ = std::chrono::steady_clock::now();
+        }
+
+        /// one line per phase that ran: calls, total and mean time, allocations and allocated bytes
+        [[nodiscard]] std::string summary() const {
+            std::string out = "phase          calls    total ms     mean us      allocs       bytes\n";
+            for (std::size_t i = 0; i < phase_count; i++) {
+                const Totals& t = totals_[i];
+                if (t.calls == 0) continue;
+                out += phase_names[i];
+                out.append(15 - phase_names[i].size(), ' ');
+                append_number(out, "%5.0f", static_cast<double>(t.calls));
+                append_number(out, "%12.3f", static_cast<double>(t.nanoseconds) / 1e6);
+                append_number(out, "%12.3f", static_cast<double>(t.nanoseconds) / 1e3 / static_cast<double>(t.calls));
+                append_number(out, "%12.0f", static_cast<double>(t.allocations));
+                append_number(out, "%12.0f", static_cast<double>(t.bytes));
+                out += '\n';
+            }
+            return out;
+        }
+
+        /// @brief The recorded events in the Chrome trace event format, for chrome://tracing or Perfetto.
+        /// @details Events are complete ("X") events on one track per thread; concatenate the traceEvents of several
+        /// threads' profiles to see them side by side.
+        [[nodiscard]] std::string chrome_trace() const {
+            std::string out = "{\"traceEvents\":[";
+            for (std::size_t i = 0; i < events_.size(); i++) {
+                const Event& e = events_[i];
+                out += i ? ",{\"name\":\"" : "{\"name\":\"";
+                out += phase_names[static_cast<std::size_t>(e.phase)];
+                out += "\",\"cat\":\"argcpp\",\"ph\":\"X\",\"ts\":";
+                append_number(out, "%.3f", static_cast<double>(e.start) / 1e3);
+                out += ",\"dur\":";
+                append_number(out, "%.3f", static_cast<double>(e.duration) / 1e3);
+                out += ",\"pid\":1,\"tid\":";
+                out += std::to_string(thread_);
+                out += '}';
+            }
+            out += "]}";
+            return out;
+        }
+    };
+
+    namespace helper {
+        /// @brief The calling thread's profile while it exists, for the counting operator new.
+        /// @details A plain pointer is constant initialized and never destroyed, so the allocation functions can read it
+        /// at any point of a thread's life. Calling profile() from there instead would construct the profile inside an
+        /// allocation, and touch it after thread_local destruction when a later destructor frees or allocates.
+        inline thread_local Profile* live_profile = nullptr;
+    }
+
+    /// the calling thread's profile
+    inline Profile& profile() {
+        struct Owner {
+            Profile profile;
+            Owner() noexcept { helper::live_profile = &profile; }
+            ~Owner() { helper::live_profile = nullptr; }
+        };
+        thread_local Owner owner;
+        return owner.profile;
+    }
+
+    namespace helper {
+        /// times the enclosing scope as one Phase of the calling thread's profile
+        class Phase_Scope {
+            Profile& profile_;
+            Phase phase_;
+            std::uint64_t allocations_;
+            std::uint64_t bytes_;
+            std::chrono::steady_clock::time_point start_;
+
+        public:
+            explicit Phase_Scope(const Phase phase)
+                : profile_(profile()), phase_(phase), allocations_(profile_.allocations), bytes_(profile_.bytes),
+                  start_(std::chrono::steady_clock::now()) {}
+
+            Phase_Scope(const Phase_Scope&) = delete;
+            Phase_Scope& operator=(const Phase_Scope&) = delete;
+
+            ~Phase_Scope() {
+                const auto end = std::chrono::steady_clock::now();
+                profile_.record(phase_, start_, end, profile_.allocations - allocations_, profile_.bytes - bytes_);
+            }
+        };
+    }
+
+    namespace helper {
+        /// @brief Where Values created on this thread allocate, nullptr for std::pmr::get_default_resource().
+        /// @details Set for the duration of a parse by Resource_Scope, so the Values a parse creates come from the
+        /// resource of the ParseResult being filled.
+        inline std::pmr::memory_resource*& value_resource() noexcept {
+            thread_local std::pmr::memory_resource* resource = nullptr;
+            return resource;
+        }
+
+        /// makes resource the thread's value resource until the end of the scope
+        class Resource_Scope {
+            std::pmr::memory_resource* previous_;
+
+        public:
+            explicit Resource_Scope(std::pmr::memory_resource* resource) noexcept : previous_(value_resource()) {
+                value_resource() = resource;
+            }
+
+            Resource_Scope(const Resource_Scope&) = delete;
+            Resource_Scope& operator=(const Resource_Scope&) = delete;
+
+            ~Resource_Scope() {
+                value_resource() = previous_;
+            }
+        };
+
+        // a Value is four words with no room for a resource pointer, so its blocks carry their resource in a header
+        struct Block_Header {
+            std::pmr::memory_resource* resource;
+            std::size_t bytes;
+        };
+        inline constexpr std::size_t block_header = alignof(std::max_align_t);
+        static_assert(sizeof(Block_Header) <= block_header);
+
+        /// allocates bytes from the thread's value resource
+        inline void* allocate_block(const std::size_t bytes) {
+            std::pmr::memory_resource* resource = value_resource();
+            if (!resource) resource = std::pmr::get_default_resource();
+            void* block = resource->allocate(block_header + bytes, alignof(std::max_align_t));
+            ::new (block) Block_Header{resource, bytes};
+            return static_cast<char*>(block) + block_header;
+        }
+
+        /// returns a block from allocate_block() to the resource it came from, whatever the thread's resource is now
+        inline void deallocate_block(void* p) noexcept {
+            void* block = static_cast<char*>(p) - block_header;
+            const Block_Header header = *static_cast<const Block_Header*>(block);
+            header.resource->deallocate(block, block_header + header.bytes, alignof(std::max_align_t));
+        }
+    }
+
+    class Value;
+    struct Argument;
+    struct Positional;
+    class Schema;
+    class ParseResult;
+    class Parser;
+
+    /// @brief Outcome of Value::get<T>().
+    /// @details error is std::errc::invalid_argument when the text is not a T, std::errc::result_out_of_range when it
+    /// is but does not fit, and value-initialized on success, mirroring std::from_chars.
+    template <typename T>
+    struct Conversion {
+        T value{};
+        std::errc error{};
+
+        explicit operator bool() const noexcept {
+            return error == std::errc{};
+        }
+    };
+
+    /// @brief Tagged value holding only its active alternative.
+    /// @details Scalars and strings of up to 16 characters are stored inline, longer strings in one owned heap buffer,
+    /// and lists out of line as a counted array of Values. Text produced by the parser is kept as a view into argv and
+    /// only copied when converted to std::string. A Value is 32 bytes, so copying one into results_ is cheap.
+    ///
+    /// Typed reads through get<T>() parse text once per type family (signed, unsigned, floating, bool) and cache the
+    /// result in the value, so repeated reads only pay for a range check. The cache is not synchronized.
+    class Value {
+    public:
+        enum class Kind : std::uint8_t {
+            empty,
+            boolean,
+            integer,
+            floating,
+            view,   // non-owning text, the referenced memory has to outlive the value
+            small,  // owned text stored inline
+            string, // owned text on the heap
+            list,
+        };
+
+    private:
+        static constexpr std::size_t small_capacity = 16;
+
+        struct Heap_String {
+            char* data;
+            std::size_t size;
+        };
+
+        struct List {
+            Value* data;
+            std::uint32_t size;
+            std::uint32_t capacity;
+        };
+
+        union {
+            bool stored_bool;
+            std::int64_t stored_int;
+            double stored_double;
+            std::string_view stored_view;
+            char stored_small[small_capacity];
+            Heap_String stored_string;
+            List stored_values;
+        };
+        Kind kind_ = Kind::empty;
+        std::uint8_t small_size_ = 0;
+
+        // conversion cache for get<T>(), see convert()
+        enum class Cache : std::uint8_t { none, signed_integer, unsigned_integer, floating, boolean };
+        mutable Cache cache_ = Cache::none;
+        mutable std::errc cache_error_{};
+        mutable union {
+            std::int64_t i;
+            std::uint64_t u;
+            double d;
+            bool b;
+        } cached_{};
+
+        static constexpr bool iequals(const std::string_view a, const std::string_view b) noexcept {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const char x, const char y) {
+                return (x | 0x20) == (y | 0x20);
+            });
+        }
+
+        /// @brief Parses text with from_chars, accepting a leading '+' and a 0x prefix for integers.
+        /// @details Only one sign is accepted, before any prefix, so "+-5" and "0x-5" are invalid. A negative number
+        /// read as an unsigned type is out of range rather than invalid.
+        template <typename N>
+        static std::errc parse_number(std::string_view text, N& out) noexcept {
+            const auto signed_next = [&text] { return text.starts_with('+') || text.starts_with('-'); };
+            if (text.starts_with('+')) {
+                text.remove_prefix(1);
+                if (signed_next()) return std::errc::invalid_argument;
+            }
+            int base = 10;
+            if constexpr (std::is_integral_v<N>) {
+                if (text.size() > 2 && text[0] == '0' && (text[1] | 0x20) == 'x') {
+                    text.remove_prefix(2);
+                    if (signed_next()) return std::errc::invalid_argument;
+                    base = 16;
+                }
+            }
+            if constexpr (std::is_unsigned_v<N>) {
+                if (text.starts_with('-')) {
+                    std::int64_t negative = 0;
+                    const std::errc error = parse_number(text, negative);
+                    if (error != std::errc{}) return error;
+                    if (negative < 0) return std::errc::result_out_of_range;
+                    out = 0;
+                    return {};
+                }
+            }
+            std::from_chars_result r{};
+            if constexpr (std::is_integral_v<N>) {
+                r = std::from_chars(text.data(), text.data() + text.size(), out, base);
+            } else {
+                r = std::from_chars(text.data(), text.data() + text.size(), out);
+            }
+            if (r.ec != std::errc{}) return r.ec;
+            if (text.empty() || r.ptr != text.data() + text.size()) return std::errc::invalid_argument;
+            return {};
+        }
+
+        /// fills the cache for one type family from the stored alternative
+        void convert(const Cache family) const noexcept {
+            cache_ = family;
+            cache_error_ = {};
+            const std::string_view text = view();
+            const bool is_text = kind_ == Kind::view || kind_ == Kind::small || kind_ == Kind::string;
+
+            switch (family) {
+                case Cache::signed_integer:
+                    if (is_text) cache_error_ = parse_number(text, cached_.i);
+                    else if (kind_ == Kind::integer) cached_.i = stored_int;
+                    else cache_error_ = std::errc::invalid_argument;
+                    break;
+                case Cache::unsigned_integer:
+                    if (is_text) cache_error_ = parse_number(text, cached_.u);
+                    else if (kind_ == Kind::integer && stored_int >= 0) cached_.u = static_cast<std::uint64_t>(stored_int);
+                    else if (kind_ == Kind::integer) cache_error_ = std::errc::result_out_of_range;
+                    else cache_error_ = std::errc::invalid_argument;
+                    break;
+                case Cache::floating:
+                    if (is_text) cache_error_ = parse_number(text, cached_.d);
+                    else if (kind_ == Kind::floating) cached_.d = stored_double;
+                    else if (kind_ == Kind::integer) cached_.d = static_cast<double>(stored_int);
+                    else cache_error_ = std::errc::invalid_argument;
+                    break;
+                case Cache::boolean:
+                    if (kind_ == Kind::boolean) cached_.b = stored_bool;
+                    else if (is_text && (iequals(text, "true") || iequals(text, "yes") || iequals(text, "on") || text == "1")) cached_.b = true;
+                    else if (is_text && (iequals(text, "false") || iequals(text, "no") || iequals(text, "off") || text == "0")) cached_.b = false;
+                    else cache_error_ = std::errc::invalid_argument;
+                    break;
+                case Cache::none:
+                    break;
+            }
+        }
+
+        void assign_text(const std::string_view s) {
+            if (s.size() <= small_capacity) {
+                std::copy(s.begin(), s.end(), stored_small);
+                small_size_ = static_cast<std::uint8_t>(s.size());
+                kind_ = Kind::small;
+            } else {
+                stored_string.data = static_cast<char*>(helper::allocate_block(s.size()));
+                std::copy(s.begin(), s.end(), stored_string.data);
+                stored_string.size = s.size();
+                kind_ = Kind::string;
+            }
+        }
+
+        void assign_list(const Value* first, const std::size_t count) {
+            stored_values = {nullptr, 0, 0};
+            kind_ = Kind::list;
+            reserve(count);
+            for (std::size_t i = 0; i < count; i++) {
+                std::construct_at(stored_values.data + i, first[i]);
+            }
+            stored_values.size = static_cast<std::uint32_t>(count);
+        }
+
+        void copy_from(const Value& other) {
+            switch (other.kind_) {
+                case Kind::string:
+                    assign_text(other.view());
+                    break;
+                case Kind::list:
+                    assign_list(other.stored_values.data, other.stored_values.size);
+                    break;
+                default:
+                    copy_trivial(other);
+            }
+            cache_ = other.cache_;
+            cache_error_ = other.cache_error_;
+            cached_ = other.cached_;
+        }
+
+        /// copies every alternative that does not own memory, and the header of the ones that do
+        void copy_trivial(const Value& other) noexcept {
+            switch (other.kind_) {
+                case Kind::boolean:  stored_bool = other.stored_bool; break;
+                case Kind::integer:  stored_int = other.stored_int; break;
+                case Kind::floating: stored_double = other.stored_double; break;
+                case Kind::view:     stored_view = other.stored_view; break;
+                case Kind::small:    std::copy_n(other.stored_small, other.small_size_, stored_small); break;
+                case Kind::string:   stored_string = other.stored_string; break;
+                case Kind::list:     stored_values = other.stored_values; break;
+                case Kind::empty:    break;
+            }
+            kind_ = other.kind_;
+            small_size_ = other.small_size_;
+        }
+
+        void steal_from(Value& other) noexcept {
+            copy_trivial(other);
+            cache_ = other.cache_;
+            cache_error_ = other.cache_error_;
+            cached_ = other.cached_;
+            other.kind_ = Kind::empty;
+            other.small_size_ = 0;
+            other.cache_ = Cache::none;
+        }
+
+    public:
+        Value() noexcept : stored_int(0) {}
+        Value(const bool b) noexcept : stored_bool(b), kind_(Kind::boolean) {}
+        Value(const int i) noexcept : stored_int(i), kind_(Kind::integer) {}
+        Value(const double d) noexcept : stored_double(d), kind_(Kind::floating) {}
+        Value(const char* s) : stored_int(0) { assign_text(s); }
+        Value(const std::string& s) : stored_int(0) { assign_text(s); }
+        Value(const std::pmr::string& s) : stored_int(0) { assign_text(s); }
+        /// stores the view without copying, the referenced memory has to outlive the value
+        Value(const std::string_view s) noexcept : stored_view(s), kind_(Kind::view) {}
+        Value(const std::vector<Value>& v) : stored_int(0) { assign_list(v.data(), v.size()); }
+
+        Value(const Value& other) : stored_int(0) { copy_from(other); }
+        Value(Value&& other) noexcept : stored_int(0) { steal_from(other); }
+
+        Value& operator=(const Value& other) {
+            if (this != &other) {
+                reset();
+                copy_from(other);
+            }
+            return *this;
+        }
+
+        Value& operator=(Value&& other) noexcept {
+            if (this != &other) {
+                reset();
+                steal_from(other);
+            }
+            return *this;
+        }
+
+        ~Value() {
+            reset();
+        }
+
+        void reset() noexcept {
+            if (kind_ == Kind::string) {
+                helper::deallocate_block(stored_string.data);
+            } else if (kind_ == Kind::list) {
+                std::destroy_n(stored_values.data, stored_values.size);
+                if (stored_values.data) helper::deallocate_block(stored_values.data);
+            }
+            kind_ = Kind::empty;
+            small_size_ = 0;
+            stored_int = 0;
+            cache_ = Cache::none;
+        }
+
+        [[nodiscard]] Kind kind() const noexcept {
+            return kind_;
+        }
+
+        /// false for empty values and for empty lists
+        [[nodiscard]] bool has_value() const noexcept {
+            return kind_ != Kind::empty && !(kind_ == Kind::list && stored_values.size == 0);
+        }
+
+        /// @brief Non-owning access to the stored text.
+        /// @details Refers either to the owned string or, for values produced by the parser, directly into argv.
+        /// Empty for values that don't hold text.
+        [[nodiscard]] std::string_view view() const noexcept {
+            switch (kind_) {
+                case Kind::view:   return stored_view;
+                case Kind::small:  return {stored_small, small_size_};
+                case Kind::string: return {stored_string.data, stored_string.size};
+                default:           return {};
+            }
+        }
+
+        /// elements of a list value, empty for any other alternative
+        [[nodiscard]] std::span<const Value> list() const noexcept {
+            if (kind_ != Kind::list) return {};
+            return {stored_values.data, stored_values.size};
+        }
+
+        /// empties a list while keeping its capacity, any other alternative is reset
+        void clear() noexcept {
+            if (kind_ != Kind::list) {
+                reset();
+                return;
+            }
+            std::destroy_n(stored_values.data, stored_values.size);
+            stored_values.size = 0;
+            cache_ = Cache::none;
+        }
+
+        /// reserves room for n list elements, turning the value into an empty list first if it holds anything else
+        void reserve(const std::size_t n) {
+            if (kind_ != Kind::list) {
+                reset();
+                stored_values = {nullptr, 0, 0};
+                kind_ = Kind::list;
+            }
+            if (n <= stored_values.capacity) return;
+
+            auto* data = static_cast<Value*>(helper::allocate_block(n * sizeof(Value)));
+            for (std::uint32_t i = 0; i < stored_values.size; i++) {
+                std::construct_at(data + i, std::move(stored_values.data[i]));
+                std::destroy_at(stored_values.data + i);
+            }
+            if (stored_values.data) helper::deallocate_block(stored_values.data);
+            stored_values.data = data;
+            stored_values.capacity = static_cast<std::uint32_t>(n);
+        }
+
+        /// appends to a list value, turning the value into a list first if it holds anything else
+        void push_back(Value v) {
+            if (kind_ != Kind::list || stored_values.size == stored_values.capacity) {
+                reserve(kind_ == Kind::list ? std::max<std::size_t>(4, stored_values.capacity * 2) : 4);
+            }
+            std::construct_at(stored_values.data + stored_values.size, std::move(v));
+            stored_values.size++;
+        }
+
+        /// @brief Appends a view, constructed in place. The referenced memory has to outlive the list.
+        /// @details The hot path when splitting large value lists, where a temporary Value per piece adds up.
+        void push_back(const std::string_view s) {
+            if (kind_ != Kind::list || stored_values.size == stored_values.capacity) {
+                reserve(kind_ == Kind::list ? std::max<std::size_t>(4, stored_values.capacity * 2) : 4);
+            }
+            std::construct_at(stored_values.data + stored_values.size, s);
+            stored_values.size++;
+        }
+
+        void push_back(const char* s) {
+            push_back(Value(s));
+        }
+
+        void push_back(const std::string& s) {
+            push_back(Value(s));
+        }
+
+        void push_back(const std::pmr::string& s) {
+            push_back(Value(s));
+        }
+
+        /// @brief Converts the value to T without throwing.
+        /// @details T is bool or any integral or floating point type. Text is parsed with std::from_chars; bools also
+        /// accept true/false, yes/no, on/off and 1/0. The parsed result is cached, so later reads of any T from the same
+        /// family are only a range check.
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        [[nodiscard]] Conversion<T> get() const noexcept {
+            Conversion<T> result;
+            if constexpr (std::is_same_v<T, bool>) {
+                if (cache_ != Cache::boolean) convert(Cache::boolean);
+                result.error = cache_error_;
+                result.value = cached_.b;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                if (cache_ != Cache::floating) convert(Cache::floating);
+                result.error = cache_error_;
+                if (result.error == std::errc{}) {
+                    const double d = cached_.d;
+                    if (std::isfinite(d) && (d > std::numeric_limits<T>::max() || d < std::numeric_limits<T>::lowest())) {
+                        result.error = std::errc::result_out_of_range;
+                    } else {
+                        result.value = static_cast<T>(d);
+                    }
+                }
+            } else if constexpr (std::is_signed_v<T>) {
+                if (cache_ != Cache::signed_integer) convert(Cache::signed_integer);
+                result.error = cache_error_;
+                if (result.error == std::errc{}) {
+                    if (!std::in_range<T>(cached_.i)) result.error = std::errc::result_out_of_range;
+                    else result.value = static_cast<T>(cached_.i);
+                }
+            } else {
+                if (cache_ != Cache::unsigned_integer) convert(Cache::unsigned_integer);
+                result.error = cache_error_;
+                if (result.error == std::errc{}) {
+                    if (!std::in_range<T>(cached_.u)) result.error = std::errc::result_out_of_range;
+                    else result.value = static_cast<T>(cached_.u);
+                }
+            }
+            return result;
+        }
+
+        /// get<T>() that falls back to fallback on any error
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        [[nodiscard]] T get_or(const T fallback) const noexcept {
+            const Conversion<T> result = get<T>();
+            return result ? result.value : fallback;
+        }
+
+        explicit operator bool() const noexcept {
+            return kind_ == Kind::boolean && stored_bool;
+        }
+
+        explicit operator double() const noexcept {
+            return kind_ == Kind::floating ? stored_double : 0.0;
+        }
+
+        explicit operator int() const noexcept {
+            return kind_ == Kind::integer ? static_cast<int>(stored_int) : 0;
+        }
+
+        /// owning copy of the stored text, this is where parsed values are materialized
+        explicit operator std::string() const {
+            return std::string(view());
+        }
+
+        explicit operator std::vector<Value>() const {
+            const auto l = list();
+            return {l.begin(), l.end()};
+        }
+    };
+
+    static_assert(sizeof(Value) <= 32, "Value should stay four words wide");
+
+    /// @brief Types a parsed value can be written into by Argument::bind(): bool, arithmetic types, enums,
+    /// std::string, std::string_view, and std::optional or std::vector of those.
+    template <typename T>
+    struct is_bindable : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+        std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>> {};
+
+    template <typename T>
+    struct is_bindable<std::optional<T>> : is_bindable<T> {};
+
+    template <typename T>
+    struct is_bindable<std::vector<T>> : std::bool_constant<is_bindable<T>::value && !std::is_same_v<T, bool>> {};
+
+    /// @brief A caller's variable that receives the value of an argument, see Argument::bind().
+    /// @details Type-erased as the variable's address and a store function instantiated for its type, so a binding is
+    /// two pointers and storing through it is one indirect call.
+    struct Binding {
+        void* target = nullptr;
+        /// converts values (one for a scalar, any number for a list) of argument id and writes them to target
+        bool (*store)(void* target, std::span<const Value> values, const Schema& schema, std::uint32_t id) = nullptr;
+
+        template <typename T>
+        static Binding to(T& target) noexcept;
+
+        explicit operator bool() const noexcept {
+            return target != nullptr;
+        }
+    };
+
+    struct Argument {
+    private:
+        Parser* parser_ = nullptr; // back-reference to the parser
+        std::uint32_t _id = 0;     // index into Parser::arguments_, shared by Schema and ParseResult
+
+        /// @brief Primary identifier for the argument in its extended form.
+        /// @details Examples: "help", "output", "verbose".
+        std::string _canonical_name;
+
+        /// @brief Single-character (or possibly multi-charactered) shorthand for the argument.
+        /// @details Empty if no short form is needed.
+        std::string _short_name;
+
+        /// @brief Additional long-form identifiers that resolve to this argument.
+        /// @details Useful for maintaining backwards compatibility or providing intuitive alternatives.
+        std::vector<std::string> _aliases;
+
+        /// @brief Human-readable explanation of the argument's purpose and behavior.
+        /// @details Displayed in help text and documentation.
+        std::string _description;
+
+        /// @brief Metavariable name shown in usage examples.
+        /// @details Typically uppercase (FILE, NUMBER, PATH) to distinguish from literal values.
+        std::string _value_name;
+
+        /// @brief Organizational label for grouping related arguments in help output.
+        /// @details Examples: "Input Options", "Network Configuration". By default it falls under a general, unnamed category.
+        std::string _category;
+
+        /// @brief Indicates whether the argument expects an associated value.
+        /// @details Mutually exclusive with is_flag in most scenarios.
+        bool _takes_value = false;
+
+        /// @brief Marks the argument as a boolean switch with no associated value.
+        /// @details Presence indicates true, absence indicates false. By default arguments are flags, meaning _min and _max_values are by default set to 0
+        bool _is_flag = true;
+
+        /// @brief Enforces that the argument must be present for valid invocation.
+        /// @details Parser will fail if this argument is missing.
+        bool _required = false;
+
+        /// @brief Fallback value used when the argument is not explicitly provided.
+        /// @details Value::empty is a flag for if _default_value is empty
+        Value _default_value;
+
+        /// @brief Lower bound on the number of values this argument can accept.
+        // if the argument is a flag both _max_values and _min_values would be 0
+        int _min_values = 0;
+
+        /// @brief Upper bound on the number of values this argument can accept.
+        /// @details Use -1 to allow unlimited values. This means all arguments after this argument would be its values.
+        int _max_values = 0;
+
+        /// @brief Restricts input to a predefined set of acceptable values.
+        /// @details Parser rejects values not present in this list.
+        std::vector<std::string> _allowed_values;
+
+        /// @brief Custom predicate for complex validation logic.
+        /// @details Return true if the value meets requirements, false otherwise.
+        std::function<bool(const std::string&)> _validator;
+
+        /// @brief Message displayed when validation fails.
+        /// @details Provides context-specific guidance to the user.
+        std::string _validation_error;
+
+        /// @brief Arguments that cannot be used simultaneously with this one.
+        /// @details Parser fails if any conflicting arguments are present together.
+        std::vector<std::string> _conflicts_with;
+
+        /// @brief Arguments that must be present if this argument is used.
+        /// @details Enforces dependencies between related options.
+        std::vector<std::string> _mandated;
+
+        /// @brief At least one argument from this list must be present if this argument is used.
+        /// @details Implements "requires any of" dependency semantics.
+        std::vector<std::string> _requires_one_of;
+
+        /// @brief Index for positional arguments that don't use flag syntax.
+        /// @details Zero indicates this is not a positional argument.
+        int _position = 0;
+
+        /// @brief Whether argument is positional
+        /// @details implies _position is > 0
+        bool _is_positional = false;
+
+        /// @brief Excludes the argument from generated help text.
+        /// @details Typically used for deprecated or internal-only options.
+        bool _hidden = false;
+
+        /// @brief Marks the argument as outdated but still functional.
+        /// @details Parser may emit a warning when deprecated arguments are used.
+        bool _deprecated = false;
+
+        /// @brief Informational message shown when a deprecated argument is encountered.
+        /// @details Should guide users toward the recommended alternative.
+        std::string _deprecated_message;
+
+        /// @brief Character used to split a single value string into multiple values.
+        /// @details Common choices: ',' for lists, ':' for paths.
+        char _value_delimiter = ',';
+
+        /// @brief Character that makes the next one literal when splitting values, '\0' for none.
+        /// @details With '\\', "a\\,b,c" gives the values "a,b" and "c".
+        char _value_escape = '\0';
+
+        /// @brief Controls whether value matching respects character case.
+        /// @details Affects both allowed_values checking and general comparison.
+        bool _case_sensitive = true;
+
+        /// @brief Permits values beginning with a hyphen character.
+        /// @details Necessary for negative numbers and certain edge cases.
+        bool _allow_hyphen_values = false;
+
+        /// @brief Environment variable consulted when the argument is not provided.
+        /// @details Offers a secondary source for configuration values.
+        std::string _env_var;
+
+        /// @brief Variable the value is written to after a successful parse.
+        /// @details Empty unless bind() was called.
+        Binding _binding;
+
+        // allow for "attribute-chaining"
+    public:
+        /// @brief Sets the primary long-form name of the argument.
+        /// @details Corresponds to the user-facing identifier used as --name.
+        Argument& long_name(const std::string &long_name) {
+            this->_canonical_name = long_name;
+            this->_value_name = long_name;
+            return *this;
+        }
+
+        /// @brief Sets the short-form name of the argument.
+        /// @details Typically a single character used with a single hyphen (e.g., -v).
+        Argument& short_name(const std::string &short_name);
+
+        /// @brief Replaces the alias list with new alternative long-form identifiers.
+        /// @details Aliases allow multiple names to refer to the same argument.
+        Argument& aliases(const std::vector<std::string> &alias_list);
+
+        /// @brief Sets the argument's description.
+        /// @details Shown in generated help and documentation.
+        Argument& help(const std::string &description) {
+            this->_description = description;
+            return *this;
+        }
+
+        /// @brief Assigns the metavariable name used when displaying usage examples.
+        /// @details Helps visually distinguish user-supplied values from literal tokens.
+        Argument& value_name(const std::string &value_name) {
+            this->_value_name = value_name;
+            return *this;
+        }
+
+        /// @brief Groups this argument under a named help section.
         /// @details Useful for organizing large sets of arguments.
         Argument& category(const std::string &category) {
             this->_category = category;
             return *this;
         }
 
-        /// @brief Marks the argument as one that accepts a value.
-        /// @details Automatically disables flag mode and ensures appropriate min/max values.
-        Argument& takes_value() {
-            this->_takes_value = true;
-            this->_is_flag = false;
-            if (this->_min_values == 0) this->_min_values = 1;
-            if (this->_max_values == 0) this->_max_values = 1;
-            return *this;
+        /// @brief Marks the argument as one that accepts a value.
+        /// @details Automatically disables flag mode and ensures appropriate min/max values.
+        Argument& takes_value() {
+            this->_takes_value = true;
+            this->_is_flag = false;
+            if (this->_min_values == 0) this->_min_values = 1;
+            if (this->_max_values == 0) this->_max_values = 1;
+            return *this;
+        }
+
+        /// @brief Declares the argument as a flag.
+        /// @details Flags do not accept values and always have min/max values set to 0.
+        Argument& is_flag() {
+            this->_is_flag = true;
+            this->_takes_value = false;
+            this->_min_values = 0;
+            this->_max_values = 0;
+            return *this;
+        }
+
+        /// @brief Marks the argument as required for valid invocation.
+        /// @details Absence of this argument during parsing results in an error.
+        Argument& required() {
+            this->_required = true;
+            return *this;
+        }
+
+        Argument& optional();
+
+        /// @brief Defines a default value that applies when the user does not supply one.
+        /// @details The default is used only if no environment variable or user input overrides it.
+        Argument& default_value(const Value& default_value) {
+            this->_default_value = default_value;
+            return *this;
+        }
+
+        /// @brief Sets both minimum and maximum number of values for the argument.
+        /// @details Flags must always have min/max values of zero. Use -1 for max_values to allow unlimited values.
+        Argument& x_value_range(const int min_values, const int max_values) {
+            if (_is_flag) {
+                if (min_values != 0 || max_values != 0)
+                    throw exceptions::add_argument_error("Flags cannot have min_values or max_values > 0.");
+                _min_values = 0;
+                _max_values = 0;
+                return *this;
+            }
+
+            if (min_values < 0)
+                throw exceptions::add_argument_error("min_values cannot be negative.");
+
+            if (max_values <= 0 && max_values != -1)
+                throw exceptions::add_argument_error("max_values must be > 0 or -1 for unlimited.");
+
+            if (max_values != -1 && min_values > max_values)
+                throw exceptions::add_argument_error("min_values cannot exceed max_values.");
+
+            _min_values = min_values;
+            _max_values = max_values;
+            return *this;
+        }
+
+        /// @brief Restricts acceptable values to the provided set.
+        /// @details The parser rejects input not contained in this list.
+        Argument& allowed_values(const std::vector<std::string> &allowed_values) {
+            this->_allowed_values = allowed_values;
+            return *this;
+        }
+
+        /// @brief Assigns a custom validation predicate for argument values.
+        /// @details The function must return true to indicate validity. It runs on every value, after the allowed
+        /// values check, and a value it rejects fails the parse with validation_error_message().
+        Argument& validate(const std::function<bool(const std::string&)>& validator) {
+            this->_validator = validator;
+            return *this;
+        }
+
+        /// @brief Sets the error message shown when validation fails.
+        /// @details Should guide the user toward acceptable input.
+        Argument& validation_error_message(const std::string& error_message) {
+            this->_validation_error = error_message;
+            return *this;
+        }
+
+        /// @brief Specifies arguments that cannot appear alongside this one.
+        /// @details Enforces mutual exclusivity.
+        Argument& conflicts_with(const std::vector<std::string> &conflicts_with) {
+            this->_conflicts_with = conflicts_with;
+            return *this;
+        }
+
+        /// @brief Specifies arguments that must also be present when this argument is used.
+        /// @details Implements strict dependency enforcement.
+        Argument& mandated(const std::vector<std::string> &mandated) {
+            this->_mandated = mandated;
+            return *this;
+        }
+
+        /// @brief Ensures that at least one argument from the given list is present.
+        /// @details Useful for alternatives such as (--tcp | --udp).
+        Argument& requires_one_of(const std::vector<std::string> &requires_one_of) {
+            this->_requires_one_of = requires_one_of;
+            return *this;
+        }
+
+        /// @brief Assigns a positional index to the argument.
+        /// @details Zero indicates a non-positional (named) argument.
+        /// @return Reference to the created/inserted Positional object.
+        Positional& position(const int position);
+
+        /// @brief Hides the argument from help output.
+        /// @details Used for deprecated or private options.
+        Argument& hidden() {
+            this->_hidden = true;
+            return *this;
+        }
+
+        /// @brief Marks the argument as deprecated.
+        /// @details Using it on the command line adds a warning to ParseResult::warnings(); the parser does not print it.
+        Argument& deprecated() {
+            this->_deprecated = true;
+            return *this;
+        }
+
+        /// @brief Provides a guidance message when the deprecated argument is used.
+        /// @details Should indicate the recommended replacement argument.
+        Argument& deprecated_message(const std::string& deprecated_message) {
+            this->_deprecated_message = deprecated_message;
+            return *this;
+        }
+
+        /// @brief Sets the delimiter used to split a single value into multiple entries.
+        /// @details Useful for comma-separated lists or path variables.
+        Argument& value_delimiter(const char delimiter) {
+            this->_value_delimiter = delimiter;
+            return *this;
+        }
+
+        /// @brief Sets a character that escapes the delimiter (or itself) inside a value list, '\0' to disable.
+        /// @details Pieces without escapes remain views into the command line; a piece with escapes is copied once
+        /// with the escape characters removed.
+        Argument& value_escape(const char escape) {
+            if (escape != '\0' && escape == this->_value_delimiter)
+                throw exceptions::add_argument_error("the escape character cannot be the value delimiter.");
+            this->_value_escape = escape;
+            return *this;
+        }
+
+        /// @brief Allows values that begin with a hyphen.
+        /// @details Required for negative numbers and file names such as "-foo".
+        Argument& allow_hyphen_value(const bool allow_hyphen_value) {
+            this->_allow_hyphen_values = allow_hyphen_value;
+            return *this;
+        }
+
+        /// @brief Controls whether values are matched against allowed_values with their case intact.
+        /// @details Case insensitive matching folds ASCII letters only.
+        Argument& case_sensitive(const bool case_sensitive) {
+            this->_case_sensitive = case_sensitive;
+            return *this;
+        }
+
+        /// @brief Specifies an environment variable to use when no argument value is provided.
+        /// @details Useful for configuration defaults and secret propagation (e.g., tokens). The environment is read
+        /// once, on the first parse, see Parser::schema().
+        Argument& env_var(const std::string &env_var) {
+            this->_env_var = env_var;
+            return *this;
+        }
+
+        /// @brief Writes the value straight into target whenever a parse succeeds.
+        /// @details target has to outlive the parser. Flags set a bool to true, enums take the index of the value in
+        /// allowed_values (or the value as an integer), vectors receive every value of a list and optionals are
+        /// engaged. Nothing is written when the argument was not given and has no default, so target keeps its own
+        /// initial value; a value that does not convert fails the parse. A std::string_view views the command line.
+        template <typename T>
+            requires is_bindable<T>::value
+        Argument& bind(T& target) {
+            this->_binding = Binding::to(target);
+            return *this;
+        }
+
+        friend class Parser;
+        friend class Schema;
+        friend class ParseResult;
+    };
+
+    struct Positional {
+        // --- identity ---
+        std::string canonical_name_;      // internal name used by Parser
+        std::string value_name_;          // shown in help text (e.g., FILE, PATH)
+
+        // --- metadata ---
+        std::string description_;         // human-readable explanation
+
+        // --- positional semantics ---
+        int position_index_ = 0;          // 0-based physical order
+        bool required_ = true;            // required unless declared optional
+        bool variadic_ = false;           // whether it consumes unlimited remaining args
+
+        // --- values ---
+        int min_values_ = 1;              // usually 1 for simple positionals
+        int max_values_ = 1;              // -1 for unlimited (only allowed for last positional)
+        Value default_value_;              // default if omitted AND optional
+
+        // --- validation ---
+        std::vector<std::string> allowed_values_;
+        bool case_sensitive_ = true;      // whether allowed_values_ are matched with their case intact
+        std::function<bool(const std::string&)> validator_;
+        std::string validation_error_;
+
+        // --- formatting ---
+        char value_delimiter_ = ',';      // allows “a,b,c” as value lists
+
+        // --- environment integration ---
+        std::string env_var_;             // optional: fallback source
+
+        // --- binding ---
+        Binding binding_;                 // variable written after a successful parse, see bind()
+
+        // --- builder-style member functions ---
+        Positional& help(const std::string& description) {
+            this->description_ = description;
+            return *this;
+        }
+
+        Positional& name(const std::string& name) {
+            this->canonical_name_ = name;
+            this->value_name_ = name;
+            return *this;
+        }
+
+        Positional& value_name(const std::string& value_name) {
+            this->value_name_ = value_name;
+            return *this;
+        }
+        Positional& default_value(const Value& default_value) {
+            this->default_value_ = default_value;
+            return *this;
+        }
+        Positional& allowed_values(const std::vector<std::string>& allowed_values) {
+            this->allowed_values_ = allowed_values;
+            return *this;
+        }
+        Positional& case_sensitive(const bool case_sensitive) {
+            this->case_sensitive_ = case_sensitive;
+            return *this;
+        }
+        Positional& validate(const std::function<bool(const std::string&)>& validator) {
+            this->validator_ = validator;
+            return *this;
+        }
+        Positional& validation_error_message(const std::string& error_message) {
+            this->validation_error_ = error_message;
+            return *this;
+        }
+        Positional& value_delimiter(const char delimiter) {
+            this->value_delimiter_ = delimiter;
+            return *this;
+        }
+        Positional& env_var(const std::string& env_var) {
+            this->env_var_ = env_var;
+            return *this;
+        }
+        Positional& required() {
+            this->required_ = true;
+            return *this;
+        }
+        Positional& optional() {
+            this->required_ = false;
+            return *this;
+        }
+        // Positional& min_values(int minval) {
+        //     this->min_values_ = minval;
+        //     return *this;
+        // }
+        // Positional& max_values(int maxval) {
+        //     this->max_values_ = maxval;
+        //     return *this;
+        // }
+
+        // TODO make this one range function ^
+        Positional& position_index(int idx) {
+            this->position_index_ = idx;
+            return *this;
+        }
+        /// takes every remaining value up to the first option, see ParseResult::tail(); only the last positional can
+        Positional& variadic(bool is_variadic = true) {
+            this->variadic_ = is_variadic;
+            return *this;
+        }
+        /// writes the value (every value, for a variadic positional bound to a vector) into target, see Argument::bind()
+        template <typename T>
+            requires is_bindable<T>::value
+        Positional& bind(T& target) {
+            this->binding_ = Binding::to(target);
+            return *this;
+        }
+    };
+
+    /// @brief Where the value of an argument came from, in increasing order of precedence.
+    enum class Source : std::uint8_t { default_value, config_file, environment, command_line };
+
+    /// @brief The values of a variadic positional.
+    /// @details Normally a span over the argv entries themselves, so even hundreds of thousands of values cost nothing
+    /// per element. When response files supplied part of the tail the values are views into their buffers instead.
+    /// Either way the elements read as std::string_view; strings() makes owning copies when they are needed.
+    class Tail {
+        std::span<const char* const> argv_;
+        std::span<const Value> values_;
+
+    public:
+        Tail() = default;
+        explicit Tail(const std::span<const char* const> argv) noexcept : argv_(argv) {}
+        explicit Tail(const std::span<const Value> values) noexcept : values_(values) {}
+
+        class iterator {
+            const Tail* tail_ = nullptr;
+            std::size_t i_ = 0;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::string_view;
+
+            iterator() = default;
+            iterator(const Tail* tail, const std::size_t i) noexcept : tail_(tail), i_(i) {}
+
+            std::string_view operator*() const noexcept { return (*tail_)[i_]; }
+            iterator& operator++() noexcept { i_++; return *this; }
+            iterator operator++(int) noexcept { iterator old = *this; i_++; return old; }
+            bool operator==(const iterator& other) const noexcept { return i_ == other.i_; }
+        };
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return argv_.empty() ? values_.size() : argv_.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        std::string_view operator[](const std::size_t i) const noexcept {
+            return argv_.empty() ? values_[i].view() : std::string_view(argv_[i]);
+        }
+
+        [[nodiscard]] iterator begin() const noexcept { return {this, 0}; }
+        [[nodiscard]] iterator end() const noexcept { return {this, size()}; }
+
+        /// the tail as the argv entries it came from, empty if response files supplied any of it
+        [[nodiscard]] std::span<const char* const> argv() const noexcept {
+            return argv_;
+        }
+
+        /// owning copies of the values
+        [[nodiscard]] std::vector<std::string> strings() const {
+            std::vector<std::string> out;
+            out.reserve(size());
+            for (const std::string_view value : *this) out.emplace_back(value);
+            return out;
+        }
+    };
+
+    /// @brief Outcome of parsing one command line against a Schema.
+    /// @details Holds all per-parse state, so any number of results can be filled concurrently from one shared Schema.
+    /// A result can be reused for further parses: reset() costs O(number of arguments the last parse touched) and keeps
+    /// the capacity of collected lists. Text values are views into the parsed argv, response files and the defaults of
+    /// the schema's arguments.
+    class ParseResult {
+        struct Response_Source {
+            char* pos;
+            char* end;
+        };
+
+        const Schema* schema_ = nullptr;
+        std::pmr::vector<Value> values_;             // one per argument id, holding the default until the argument is given
+        std::pmr::vector<std::uint64_t> provided_;   // bitset over argument ids
+        std::pmr::vector<std::uint32_t> touched_;    // ids given by the last parse, in order of first appearance
+        std::pmr::vector<Source> sources_;           // by id
+        std::span<const char* const> tail_;            // variadic positional, when it lies in argv
+        std::uint32_t command_ = helper::Trie::npos;   // subcommand named on the command line
+        std::span<const char* const> command_args_;    // argv of the subcommand, starting with its name
+        std::pmr::vector<helper::Mapped_File> response_files_; // keeps the memory of response file tokens alive
+        std::pmr::vector<Response_Source> response_stack_;     // scratch for the tokenizer
+        std::pmr::string error_;
+        std::pmr::vector<std::pmr::string> warnings_;   // deprecated arguments that were used
+        bool ok_ = true;
+
+        void bind(const Schema& schema);
+
+        /// @brief Copy of a default that shares its text with the schema's argument instead of allocating.
+        /// @details Defaults live as long as the Parser the result refers to, so viewing their text is safe, and it keeps
+        /// bind() and reset() free of allocations for long string defaults.
+        static Value borrowed(const Value& default_value) {
+            if (default_value.kind() == Value::Kind::string) return Value(default_value.view());
+            if (default_value.kind() != Value::Kind::list) return default_value;
+            Value list;
+            list.reserve(default_value.list().size());
+            for (const Value& element : default_value.list()) list.push_back(borrowed(element));
+            return list;
+        }
+
+        /// puts the default of a list argument back into its slot, reusing the slot's capacity
+        void restore_list(const std::uint32_t id, const Value& default_value) {
+            Value& slot = values_[id];
+            slot.clear();
+            for (const Value& element : default_value.list()) slot.push_back(borrowed(element));
+        }
+
+        /// takes the defaults of an already bound, untouched result without recomputing them
+        void seed_from(const ParseResult& pristine) {
+            schema_ = pristine.schema_;
+            values_ = pristine.values_;
+            provided_ = pristine.provided_;
+            sources_ = pristine.sources_;
+        }
+
+        /// marks id as provided, remembering it so reset() can undo the parse
+        /// @return true the first time id is touched
+        bool touch(const std::uint32_t id) {
+            std::uint64_t& word = provided_[id / 64];
+            const std::uint64_t bit = std::uint64_t{1} << (id % 64);
+            if (word & bit) return false;
+            word |= bit;
+            touched_.push_back(id);
+            sources_[id] = Source::command_line;
+            return true;
+        }
+
+        bool fail(const std::string_view message) {
+            if (ok_) error_.assign(message);
+            ok_ = false;
+            return false;
+        }
+
+        friend class Schema;
+        friend class Parser;
+
+    public:
+        static constexpr std::uint32_t npos = helper::Perfect_Hash::npos;
+
+        ParseResult() = default;
+
+        /// @brief A result whose parses allocate from resource, including the text and lists of the Values they store and
+        /// the error and warning messages.
+        /// @details With a std::pmr::monotonic_buffer_resource a parse allocates nothing from the global heap and its
+        /// memory is released in one step. The result has to be destroyed before the resource is released.
+        explicit ParseResult(std::pmr::memory_resource* resource)
+            : values_(resource), provided_(resource), touched_(resource), sources_(resource), response_files_(resource),
+              response_stack_(resource), error_(resource), warnings_(resource) {}
+
+        /// the memory resource of this result's parses
+        [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+            return values_.get_allocator().resource();
+        }
+
+        /// false if the parse reported an error, see error()
+        [[nodiscard]] bool ok() const noexcept {
+            return ok_;
+        }
+
+        explicit operator bool() const noexcept {
+            return ok_;
+        }
+
+        /// description of the first error of the parse, empty if it succeeded; valid until the next parse or reset()
+        [[nodiscard]] std::string_view error() const noexcept {
+            return error_;
+        }
+
+        /// one message per deprecated argument the command line used, see Argument::deprecated()
+        [[nodiscard]] const std::pmr::vector<std::pmr::string>& warnings() const noexcept {
+            return warnings_;
+        }
+
+        [[nodiscard]] const Schema* schema() const noexcept {
+            return schema_;
+        }
+
+        /// @brief Value of an argument, looked up by any of its names.
+        /// @details Text values are views into argv; convert with std::string(...) for an owning copy.
+        const Value& get(std::string_view name) const;
+
+        /// whether the argument was given on the command line, through its environment variable or in a config file
+        bool provided(std::string_view name) const;
+
+        /// @brief Index of the argument's value within its allowed values, see Schema::choice().
+        /// @details For an argument that collects a list, use Schema::choice() on each element instead.
+        std::uint32_t choice(std::string_view name) const;
+
+        /// value of the argument with the given id, see Schema::id()
+        [[nodiscard]] const Value& at(const std::uint32_t id) const noexcept {
+            return values_[id];
+        }
+
+        [[nodiscard]] bool provided(const std::uint32_t id) const noexcept {
+            return (provided_[id / 64] >> (id % 64)) & 1;
+        }
+
+        /// where the value of the argument with the given id came from
+        [[nodiscard]] Source source(const std::uint32_t id) const noexcept {
+            return sources_[id];
+        }
+
+        /// where the value of an argument came from, looked up by any of its names
+        Source source(std::string_view name) const;
+
+        /// @brief Values of the variadic positional, looked up by its name.
+        /// @details Empty for any other argument. The values reference argv (or response file buffers) directly.
+        Tail tail(std::string_view name) const;
+
+        /// index of the subcommand given on the command line, in the order of Parser::add_subcommand(), npos if none
+        [[nodiscard]] std::uint32_t subcommand() const noexcept {
+            return command_;
+        }
+
+        /// the part of the command line that belongs to the subcommand, laid out like argv with its name first
+        [[nodiscard]] std::span<const char* const> subcommand_args() const noexcept {
+            return command_args_;
+        }
+
+        /// ids of the arguments given on the command line, in order of first appearance
+        [[nodiscard]] std::span<const std::uint32_t> touched() const noexcept {
+            return touched_;
+        }
+
+        /// clears the parse, restoring the defaults of the touched arguments
+        void reset();
+    };
+
+    /// @brief Compiled, immutable form of a Parser's arguments.
+    /// @details Produced by Parser::compile(). Nothing in a Schema changes after it is built and parse() only writes to
+    /// the ParseResult it is handed, so one Schema can be shared by any number of threads without locking. The Schema
+    /// refers to the arguments owned by its Parser, which has to outlive it.
+    class Schema {
+        std::vector<const Argument*> arguments_; // by id
+        helper::Perfect_Hash lookup_;
+        std::vector<std::uint32_t> required_;    // named arguments that must be given
+        std::vector<std::uint32_t> positionals_; // required positionals, in order
+        std::uint32_t variadic_ = helper::Perfect_Hash::npos; // the last positional, when it takes all remaining values
+        std::size_t variadic_min_ = 1;
+        std::vector<std::uint32_t> choice_of_;   // by id, index into choices_ or npos when any value is allowed
+        std::vector<helper::Choice_Set> choices_;
+
+        // conflicts_with, mandated (transitively closed) and requires_one_of, resolved to ids. Each set is a bitset of
+        // words_ words stored at an offset into bits_; constraint_of_ maps an id to its entry, npos when unconstrained.
+        struct Constraint {
+            std::uint32_t conflicts = helper::Perfect_Hash::npos;
+            std::uint32_t mandated = helper::Perfect_Hash::npos;
+            std::uint32_t one_of = helper::Perfect_Hash::npos;
+        };
+        std::vector<std::uint32_t> constraint_of_;
+        std::vector<Constraint> constraints_;
+        std::vector<std::uint64_t> bits_;
+        std::size_t words_ = 0;
+
+        // environment fallbacks, captured in one pass over environ on the first parse, see Parser::capture_sources()
+        struct Env_Value {
+            std::uint32_t id;
+            std::string value;
+        };
+        std::vector<Env_Value> env_values_;   // only arguments whose variable is set
+        std::vector<std::uint32_t> env_of_;   // by id, index into env_values_ or npos
+
+        // config file fallbacks: the files stay mapped and values are views into them
+        struct Config_Value {
+            std::uint32_t id;
+            std::string_view value;
+        };
+        std::vector<helper::Mapped_File> config_files_;
+        std::vector<Config_Value> config_values_;
+        std::vector<std::uint32_t> config_of_; // by id, index into config_values_ or npos
+        std::string source_error_;             // a required config file that could not be read, fails every parse
+
+        helper::Trie commands_; // subcommand words, see Parser::add_subcommand()
+
+        bool response_files_ = false;
+
+        static constexpr std::size_t max_response_depth = 64;
+        static constexpr std::size_t large_list = 4096; // bytes of a value list worth counting before splitting
+
+        /// @brief " (did you mean ...?)" for a name that is not in the schema, or an empty string.
+        /// @details Ranks every visible name, alias and short name by edit distance to name and offers up to three of the
+        /// closest. Only names within about a third of the typed length are considered, so unrelated names are never
+        /// suggested. Only runs on the error path.
+        [[nodiscard]] std::string suggest(const std::string_view name) const {
+            if (name.empty()) return {};
+            const helper::Edit_Distance distance(name);
+            const std::size_t limit = std::clamp<std::size_t>((name.size() + 1) / 3, 1, 3);
+
+            struct Candidate {
+                std::size_t distance;
+                std::size_t order;
+                std::string_view dashes;
+                std::string_view name;
+            };
+            std::vector<Candidate> found;
+            const auto consider = [&](const std::string_view dashes, const std::string_view candidate) {
+                if (candidate.empty()) return;
+                const std::size_t d = distance(candidate, limit);
+                if (d != helper::Edit_Distance::npos) found.push_back({d, found.size(), dashes, candidate});
+            };
+            for (const Argument* arg : arguments_) {
+                if (arg->_hidden || arg->_is_positional) continue;
+                consider("--", arg->_canonical_name);
+                for (const auto& alias : arg->_aliases) consider("--", alias);
+                consider("-", arg->_short_name);
+            }
+            if (found.empty()) return {};
+
+            const std::size_t shown = std::min<std::size_t>(found.size(), 3);
+            std::partial_sort(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(shown), found.end(),
+                [](const Candidate& a, const Candidate& b) { return std::tie(a.distance, a.order) < std::tie(b.distance, b.order); });
+            std::string text = " (did you mean ";
+            for (std::size_t i = 0; i < shown; i++) {
+                if (i) text += i + 1 == shown ? " or " : ", ";
+                text += '"';
+                text += found[i].dashes;
+                text += found[i].name;
+                text += '"';
+            }
+            return text + "?)";
+        }
+
+        /// state of a single parse: the token stream over argv and response files, and the result being filled
+        class Cursor {
+            const Schema& schema_;
+            ParseResult& result_;
+            std::span<const char* const> args_;
+            std::size_t index_ = 1; // args_[0] is the program name
+            std::string_view peeked_;
+            bool has_peeked_ = false;
+
+        public:
+            Cursor(const Schema& schema, ParseResult& result, const std::span<const char* const> args)
+                : schema_(schema), result_(result), args_(args) {}
+
+            bool open_response_file(const std::string_view path) {
+                if (result_.response_stack_.size() == max_response_depth) {
+                    return result_.fail("response files nested too deeply at \"@" + std::string(path) + "\"");
+                }
+                helper::Mapped_File& file = result_.response_files_.emplace_back(std::string(path));
+                if (!file.ok()) {
+                    return result_.fail("cannot read response file \"" + std::string(path) + "\"");
+                }
+                result_.response_stack_.push_back({file.data(), file.data() + file.size()});
+                return true;
+            }
+
+            /// pulls the next raw token, expanding @path tokens in place when response files are enabled
+            bool fetch(std::string_view& token) {
+                ARGCPP_PHASE(tokenize);
+                auto& stack = result_.response_stack_;
+                for (;;) {
+                    if (!stack.empty()) {
+                        if (!helper::next_response_token(stack.back().pos, stack.back().end, token)) {
+                            stack.pop_back();
+                            continue;
+                        }
+                    } else if (index_ < args_.size()) {
+                        token = args_[index_++];
+                    } else {
+                        return false;
+                    }
+
+                    if (schema_.response_files_ && token.size() > 1 && token.front() == '@') {
+                        if (!open_response_file(token.substr(1))) return false;
+                        continue;
+                    }
+                    return true;
+                }
+            }
+
+            bool peek(std::string_view& token) {
+                if (!has_peeked_) has_peeked_ = fetch(peeked_);
+                token = peeked_;
+                return has_peeked_;
+            }
+
+            bool next(std::string_view& token) {
+                const bool ok = peek(token);
+                has_peeked_ = false;
+                return ok;
+            }
+
+            /// checks value against the allowed values of argument id, if it has any
+            bool check_choice(const std::uint32_t id, const std::string_view value) {
+                ARGCPP_PHASE(validate);
+                const std::uint32_t set = schema_.choice_of_[id];
+                if (set == npos || schema_.choices_[set].find(value) != npos) return check_validator(id, value);
+
+                const auto& choices = schema_.choices_[set].choices();
+                std::string message = "invalid value \"" + std::string(value) + "\" for argument \"" + schema_.arguments_[id]->_canonical_name + "\"";
+                // several hundred choices would drown the message, help lists them all
+                if (choices.size() <= 8) {
+                    message += ", expected one of";
+                    for (std::size_t i = 0; i < choices.size(); i++) {
+                        message += i ? ", " : " ";
+                        message += choices[i];
+                    }
+                }
+                return result_.fail(message);
+            }
+
+            /// runs the validate() predicate of argument id on value, if it has one
+            bool check_validator(const std::uint32_t id, const std::string_view value) {
+                const Argument& arg = *schema_.arguments_[id];
+                if (!arg._validator || arg._validator(std::string(value))) return true;
+                std::string message = "invalid value \"" + std::string(value) + "\" for argument \"" + arg._canonical_name + "\"";
+                if (!arg._validation_error.empty()) message += ": " + arg._validation_error;
+                return result_.fail(message);
+            }
+
+            /// records a warning when the command line uses a deprecated argument
+            void note_deprecated(const Argument& arg) {
+                if (!arg._deprecated) return;
+                std::string warning = "argument \"" + arg._canonical_name + "\" is deprecated";
+                if (!arg._deprecated_message.empty()) warning += ": " + arg._deprecated_message;
+                result_.warnings_.emplace_back(warning);
+            }
+
+            /// adds a value token to arg, splitting it on the delimiter when arg accepts more than one value
+            /// @return false if arg would exceed its maximum number of values, or if a value is not one of its allowed
+            /// values, which has already been reported
+            bool add_value(const Argument& arg, const std::string_view token, std::size_t& count) {
+                ARGCPP_PHASE(split);
+                Value& slot = result_.values_[arg._id];
+                if (arg._max_values == 1) {
+                    if (count == 1 || !check_choice(arg._id, token)) return false;
+                    slot = token;
+                    count = 1;
+                    return true;
+                }
+                // a long list is counted first (another vectorized pass) so the values land in one allocation
+                if (token.size() >= large_list) {
+                    std::size_t pieces = helper::count(token, arg._value_delimiter) + 1;
+                    if (arg._max_values != -1) pieces = std::min(pieces, static_cast<std::size_t>(arg._max_values));
+                    slot.reserve(slot.list().size() + pieces);
+                }
+                bool fits = true;
+                const auto add = [&](const std::string_view piece, const bool escaped) {
+                    if (!fits) return;
+                    if (arg._max_values != -1 && count >= static_cast<std::size_t>(arg._max_values)) {
+                        fits = false;
+                        return;
+                    }
+                    if (escaped) {
+                        std::pmr::memory_resource* resource = helper::value_resource();
+                        const std::pmr::string text = helper::unescape(piece, arg._value_escape, resource ? resource : std::pmr::get_default_resource());
+                        if (!(fits = check_choice(arg._id, text))) return;
+                        slot.push_back(Value(text));
+                    } else {
+                        if (!(fits = check_choice(arg._id, piece))) return;
+                        slot.push_back(piece);
+                    }
+                    count++;
+                };
+                if (arg._value_escape) {
+                    helper::split_escaped(token, arg._value_delimiter, arg._value_escape, add);
+                } else if (schema_.choice_of_[arg._id] != npos || arg._validator || arg._max_values != -1) {
+                    helper::split(token, arg._value_delimiter, [&add](const std::string_view piece) { add(piece, false); });
+                } else {
+                    // unlimited and unchecked: nothing to decide per piece
+                    const std::size_t before = slot.list().size();
+                    helper::split(token, arg._value_delimiter, [&slot](const std::string_view piece) { slot.push_back(piece); });
+                    count += slot.list().size() - before;
+                }
+                return fits;
+            }
+
+            /// reads the values of one occurrence of a named argument, starting with the one given through --name=value
+            bool parse_values(const Argument& arg, const std::string_view name, const std::string_view inline_value, const bool has_inline) {
+                if (arg._is_flag) {
+                    if (has_inline) {
+                        return result_.fail("argument \"" + std::string(name) + "\" does not take a value");
+                    }
+                    result_.values_[arg._id] = true;
+                    return true;
+                }
+
+                std::size_t count = 0;
+                if (has_inline && !add_value(arg, inline_value, count)) {
+                    return result_.fail("too many values for argument \"" + std::string(name) + "\"");
+                }
+                std::string_view token;
+                while ((arg._max_values == -1 || count < static_cast<std::size_t>(arg._max_values)) && peek(token)) {
+                    if (is_option(token) && !arg._allow_hyphen_values) break;
+                    if (!add_value(arg, token, count)) {
+                        return result_.fail("too many values for argument \"" + std::string(name) + "\"");
+                    }
+                    has_peeked_ = false;
+                }
+                if (!result_.ok_) return false;
+                if (count < static_cast<std::size_t>(arg._min_values)) {
+                    return result_.fail("argument \"" + std::string(name) + "\" expects at least " + std::to_string(arg._min_values) + " value(s)");
+                }
+                return true;
+            }
+
+            /// @brief Reads the values of the variadic positional, up to the first option.
+            /// @details While the values come straight from argv they are only delimited, as a span over args_. When a
+            /// response file supplies any of them, or a token has already been read, the tail is collected through
+            /// peek() as views in the argument's value list instead. Every value is checked against allowed_values.
+            bool parse_tail(const std::uint32_t id) {
+                const auto is_response = [this](const std::string_view t) { return schema_.response_files_ && t.size() > 1 && t.front() == '@'; };
+                std::size_t count = 0;
+                bool contiguous = false;
+                if (!has_peeked_ && result_.response_stack_.empty()) {
+                    std::size_t end = index_;
+                    for (; end < args_.size() && !is_option(args_[end]) && !is_response(args_[end]); end++) {
+                        if (!check_choice(id, args_[end])) return false;
+                    }
+                    result_.tail_ = args_.subspan(index_, end - index_);
+                    count = end - index_;
+                    index_ = end;
+                    contiguous = end == args_.size() || !is_response(args_[end]);
+                }
+                if (!contiguous) {
+                    Value& list = result_.values_[id];
+                    list.clear();
+                    for (const char* value : result_.tail_) list.push_back(std::string_view(value));
+                    result_.tail_ = {};
+                    std::string_view token;
+                    while (peek(token) && !is_option(token)) {
+                        if (!check_choice(id, token)) return false;
+                        list.push_back(token);
+                        has_peeked_ = false;
+                        count++;
+                    }
+                    if (!result_.ok_) return false;
+                }
+                if (count < schema_.variadic_min_) {
+                    return result_.fail("argument \"" + schema_.arguments_[id]->_canonical_name + "\" expects at least " + std::to_string(schema_.variadic_min_) + " value(s)");
+                }
+                result_.touch(id);
+                if (count) note_deprecated(*schema_.arguments_[id]);
+                return true;
+            }
+
+            bool parse_positional_arguments() {
+                for (const std::uint32_t id : schema_.positionals_) {
+                    if (id == schema_.variadic_) {
+                        if (!parse_tail(id)) return false;
+                        continue;
+                    }
+                    std::string_view token;
+                    Source source = Source::command_line;
+                    if (!next(token)) {
+                        if (!result_.ok_) return false;
+                        if (schema_.env_of_[id] != npos) {
+                            token = schema_.env_values_[schema_.env_of_[id]].value;
+                            source = Source::environment;
+                        } else if (schema_.config_of_[id] != npos) {
+                            token = schema_.config_values_[schema_.config_of_[id]].value;
+                            source = Source::config_file;
+                        } else {
+                            return result_.fail("There are less than required number of positionals");
+                        }
+                    }
+                    if (!check_choice(id, token)) return false;
+                    result_.values_[id] = token;
+                    result_.touch(id);
+                    result_.sources_[id] = source;
+                    if (source == Source::command_line) note_deprecated(*schema_.arguments_[id]);
+                }
+                return true;
+            }
+
+            bool check_required() {
+                ARGCPP_PHASE(constraints);
+                for (const std::uint32_t id : schema_.required_) {
+                    if (!result_.provided(id)) {
+                        return result_.fail("missing required argument \"" + schema_.arguments_[id]->_canonical_name + "\"");
+                    }
+                }
+                return true;
+            }
+
+            /// @brief Gives an argument the command line left out a value from a fallback source.
+            /// @return false if the value does not fit the argument, which has been reported
+            bool apply_fallback(const std::uint32_t id, const std::string_view value, const Source source) {
+                const Argument& arg = *schema_.arguments_[id];
+                if (arg._is_positional || result_.provided(id)) return true;
+                if (arg._is_flag && !helper::is_truthy(value)) return true;
+                result_.touch(id);
+                result_.sources_[id] = source;
+                if (arg._is_flag) {
+                    result_.values_[id] = true;
+                    return true;
+                }
+                if (is_list(arg)) result_.values_[id].clear();
+                std::size_t count = 0;
+                if (!add_value(arg, value, count)) {
+                    return result_.fail("too many values for argument \"" + arg._canonical_name + "\" in " +
+                        (source == Source::environment ? "its environment variable" : "a config file"));
+                }
+                return true;
+            }
+
+            /// fills arguments the command line left out from the environment snapshot, then from the config files
+            bool apply_fallbacks() {
+                {
+                    ARGCPP_PHASE(environment);
+                    for (const auto& [id, value] : schema_.env_values_) {
+                        if (!apply_fallback(id, value, Source::environment)) return false;
+                    }
+                }
+                ARGCPP_PHASE(config);
+                for (const auto& [id, value] : schema_.config_values_) {
+                    if (!apply_fallback(id, value, Source::config_file)) return false;
+                }
+                return true;
+            }
+
+            /// @brief Checks conflicts_with, mandated and requires_one_of of every argument the parse touched.
+            /// @details Each check intersects a precompiled bitset with the provided bitset, so the cost grows with the
+            /// number of arguments given rather than with the size of the schema.
+            bool check_constraints() {
+                ARGCPP_PHASE(constraints);
+                const std::uint64_t* provided = result_.provided_.data();
+                const std::size_t words = schema_.words_;
+                // first argument in set that is (or, with missing, is not) provided, npos if there is none
+                const auto first = [&](const std::uint32_t set, const bool missing) -> std::uint32_t {
+                    const std::uint64_t* bits = schema_.bits_.data() + set;
+                    for (std::size_t w = 0; w < words; w++) {
+                        const std::uint64_t hit = bits[w] & (missing ? ~provided[w] : provided[w]);
+                        if (hit) return static_cast<std::uint32_t>(w * 64 + std::countr_zero(hit));
+                    }
+                    return npos;
+                };
+                const auto name = [&](const std::uint32_t id) {
+                    return "\"" + schema_.arguments_[id]->_canonical_name + "\"";
+                };
+
+                for (const std::uint32_t id : result_.touched_) {
+                    const std::uint32_t c = schema_.constraint_of_[id];
+                    if (c == npos) continue;
+                    const Constraint& constraint = schema_.constraints_[c];
+
+                    if (constraint.conflicts != npos) {
+                        if (const std::uint32_t other = first(constraint.conflicts, false); other != npos) {
+                            return result_.fail("argument " + name(id) + " cannot be used with " + name(other));
+                        }
+                    }
+                    if (constraint.mandated != npos) {
+                        if (const std::uint32_t other = first(constraint.mandated, true); other != npos) {
+                            return result_.fail("argument " + name(id) + " requires " + name(other));
+                        }
+                    }
+                    if (constraint.one_of != npos && first(constraint.one_of, false) == npos) {
+                        std::string message = "argument " + name(id) + " requires one of";
+                        const auto& options = schema_.arguments_[id]->_requires_one_of;
+                        for (std::size_t i = 0; i < options.size(); i++) message += (i ? ", \"" : " \"") + options[i] + "\"";
+                        return result_.fail(message);
+                    }
+                }
+                return true;
+            }
+
+            void run() {
+                if (!schema_.source_error_.empty()) {
+                    result_.fail(schema_.source_error_);
+                    return;
+                }
+                if (!parse_positional_arguments()) return;
+
+                std::string_view token;
+                while (next(token)) {
+                    // a subcommand word ends this command's arguments; the rest of argv belongs to the subcommand
+                    if (!schema_.commands_.empty() && !is_option(token) && result_.response_stack_.empty()) {
+                        std::uint32_t command;
+                        {
+                            ARGCPP_PHASE(lookup);
+                            command = schema_.commands_.find(token);
+                        }
+                        if (command != npos) {
+                            result_.command_ = command;
+                            result_.command_args_ = args_.subspan(index_ - 1);
+                            break;
+                        }
+                    }
+
+                    std::string_view name = token;
+                    remove_prefix(name);
+
+                    // --name=value
+                    std::string_view inline_value;
+                    const std::size_t eq = name.find('=');
+                    const bool has_inline = eq != std::string_view::npos;
+                    if (has_inline) {
+                        inline_value = name.substr(eq + 1);
+                        name = name.substr(0, eq);
+                    }
+
+                    const Argument* argument;
+                    {
+                        ARGCPP_PHASE(lookup);
+                        argument = schema_.find(name);
+                    }
+
+                    // if it does not match any allowed arguments
+                    if (!argument) { result_.fail("unknown argument \"" + std::string(token) + "\"" + schema_.suggest(name)); return; }
+
+                    // a list collects across occurrences, but starts over from its default on the first one
+                    if (result_.touch(argument->_id)) {
+                        if (is_list(*argument)) result_.values_[argument->_id].clear();
+                        note_deprecated(*argument);
+                    }
+                    if (!parse_values(*argument, name, inline_value, has_inline)) return;
+                }
+                if (!result_.ok_) return;
+
+                if (!apply_fallbacks()) return;
+                if (!check_required()) return;
+                check_constraints();
+            }
+        };
+
+        static void remove_prefix(std::string_view& str) {
+            if (str.starts_with("--")) {
+                str.remove_prefix(2);
+            } else if (str.starts_with("-")) {
+                str.remove_prefix(1);
+            }
+        }
+
+        /// a token that should be read as an option rather than as a value
+        static bool is_option(const std::string_view token) {
+            return token.size() > 1 && token.front() == '-';
+        }
+
+        static bool is_list(const Argument& arg) {
+            return !arg._is_positional && arg._max_values != 0 && arg._max_values != 1;
+        }
+
+        friend class Parser;
+        friend class ParseResult;
+
+    public:
+        static constexpr std::uint32_t npos = helper::Perfect_Hash::npos;
+
+        /// id of the argument with the given canonical name, short name or alias, npos if unknown
+        [[nodiscard]] std::uint32_t id(const std::string_view name) const noexcept {
+            return lookup_.find(name);
+        }
+
+        /// resolves a name (canonical, short or alias) through the compiled table, nullptr if unknown
+        [[nodiscard]] const Argument* find(const std::string_view name) const noexcept {
+            const std::uint32_t i = lookup_.find(name);
+            return i == npos ? nullptr : arguments_[i];
+        }
+
+        /// number of arguments, ids are [0, size())
+        [[nodiscard]] std::size_t size() const noexcept {
+            return arguments_.size();
+        }
+
+        /// @brief Index of value within the allowed values of argument id, so callers can switch on an integer.
+        /// @return npos if the argument has no allowed values or value is not one of them
+        [[nodiscard]] std::uint32_t choice(const std::uint32_t id, const std::string_view value) const noexcept {
+            const std::uint32_t set = choice_of_[id];
+            return set == npos ? npos : choices_[set].find(value);
+        }
+
+        /// @brief Parses a command line into result, reusing its memory.
+        /// @details args has the layout of main's argv, args[0] being the program name. The strings in args have to
+        /// outlive the result. Safe to call concurrently as long as every thread uses its own result.
+        void parse(const std::span<const char* const> args, ParseResult& result) const {
+            ARGCPP_PHASE(parse);
+            const helper::Resource_Scope scope(result.resource());
+            if (result.schema_ != this) result.bind(*this);
+            else result.reset();
+
+            Cursor(*this, result, args).run();
+        }
+
+        [[nodiscard]] ParseResult parse(const std::span<const char* const> args, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+            ParseResult result(resource);
+            parse(args, result);
+            return result;
+        }
+
+        /// @brief Parses many command lines in parallel.
+        /// @details commands is a random access range whose elements convert to std::span<const char* const>, each laid
+        /// out like main's argv. The work is spread over threads workers (hardware concurrency when 0) that steal from
+        /// each other, and every worker seeds its results from one bound result instead of recomputing the defaults.
+        /// The results allocate from resource, like ParseResult(std::pmr::memory_resource*); the workers share it, so it
+        /// has to be thread-safe, e.g. a std::pmr::synchronized_pool_resource.
+        /// @return one result per command line, in input order. Errors are reported per result.
+        template <std::ranges::random_access_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<const R&>, std::span<const char* const>>
+        [[nodiscard]] std::vector<ParseResult> parse_batch(const R& commands, const unsigned threads = 0,
+                                                           std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+            const auto n = static_cast<std::size_t>(std::ranges::size(commands));
+            std::vector<ParseResult> results;
+            results.reserve(n);
+            for (std::size_t i = 0; i < n; i++) results.emplace_back(resource);
+
+            std::vector<ParseResult> pristine(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads);
+            helper::parallel_for(n, static_cast<unsigned>(pristine.size()), [&](const std::size_t i, const unsigned worker) {
+                ParseResult& seed = pristine[worker];
+                if (seed.schema_ != this) {
+                    const helper::Resource_Scope scope(seed.resource());
+                    seed.bind(*this);
+                }
+
+                ARGCPP_PHASE(parse);
+                ParseResult& result = results[i];
+                const helper::Resource_Scope scope(result.resource());
+                result.seed_from(seed);
+                Cursor(*this, result, std::ranges::begin(commands)[static_cast<std::ptrdiff_t>(i)]).run();
+            });
+            return results;
+        }
+    };
+
+    inline void ParseResult::bind(const Schema& schema) {
+        schema_ = &schema;
+        values_.clear();
+        values_.reserve(schema.size());
+        for (const Argument* arg : schema.arguments_) {
+            Value& v = values_.emplace_back(borrowed(arg->_default_value));
+            if (Schema::is_list(*arg) && !v.has_value() && arg->_max_values > 1) v.reserve(arg->_max_values);
+        }
+        provided_.assign((schema.size() + 63) / 64, 0);
+        sources_.assign(schema.size(), Source::default_value);
+        touched_.clear();
+        touched_.reserve(schema.size());
+        tail_ = {};
+        command_ = npos;
+        command_args_ = {};
+        response_files_.clear();
+        response_stack_.clear();
+        error_.clear();
+        warnings_.clear();
+        ok_ = true;
+    }
+
+    inline void ParseResult::reset() {
+        if (schema_) {
+            for (const std::uint32_t id : touched_) {
+                const Argument& arg = *schema_->arguments_[id];
+                provided_[id / 64] &= ~(std::uint64_t{1} << (id % 64));
+                sources_[id] = Source::default_value;
+                // lists keep their capacity for the next parse, defaults are restored as views, see borrowed()
+                if (Schema::is_list(arg) && !arg._default_value.has_value()) values_[id].clear();
+                else if (arg._default_value.kind() == Value::Kind::list) restore_list(id, arg._default_value);
+                else values_[id] = borrowed(arg._default_value);
+            }
+        }
+        touched_.clear();
+        tail_ = {};
+        command_ = npos;
+        command_args_ = {};
+        response_files_.clear();
+        response_stack_.clear();
+        error_.clear();
+        warnings_.clear();
+        ok_ = true;
+    }
+
+    inline const Value& ParseResult::get(const std::string_view name) const {
+        const std::uint32_t id = schema_ ? schema_->id(name) : npos;
+        if (id == npos) {
+            throw exceptions::unknown_argument_error("unknown argument \"" + std::string(name) + "\"");
+        }
+        return values_[id];
+    }
+
+    inline bool ParseResult::provided(const std::string_view name) const {
+        const std::uint32_t id = schema_ ? schema_->id(name) : npos;
+        if (id == npos) {
+            throw exceptions::unknown_argument_error("unknown argument \"" + std::string(name) + "\"");
+        }
+        return provided(id);
+    }
+
+    inline Tail ParseResult::tail(const std::string_view name) const {
+        const std::uint32_t id = schema_ ? schema_->id(name) : npos;
+        if (id == npos) {
+            throw exceptions::unknown_argument_error("unknown argument \"" + std::string(name) + "\"");
+        }
+        if (id != schema_->variadic_) return {};
+        return tail_.empty() ? Tail(values_[id].list()) : Tail(tail_);
+    }
+
+    inline Source ParseResult::source(const std::string_view name) const {
+        const std::uint32_t id = schema_ ? schema_->id(name) : npos;
+        if (id == npos) {
+            throw exceptions::unknown_argument_error("unknown argument \"" + std::string(name) + "\"");
+        }
+        return source(id);
+    }
+
+    inline std::uint32_t ParseResult::choice(const std::string_view name) const {
+        const std::uint32_t id = schema_ ? schema_->id(name) : npos;
+        if (id == npos) {
+            throw exceptions::unknown_argument_error("unknown argument \"" + std::string(name) + "\"");
+        }
+        return schema_->choice(id, values_[id].view());
+    }
+
+    /// shells that Parser::completion_script() can generate a completion script for
+    enum class Shell { bash, zsh, fish };
+
+    namespace binding {
+        /// converts one value of argument id to T, false if it does not convert
+        template <typename T>
+        bool convert(const Value& value, T& out, const Schema& schema, const std::uint32_t id) {
+            if constexpr (std::is_enum_v<T>) {
+                if (const std::uint32_t index = schema.choice(id, value.view()); index != Schema::npos) {
+                    out = static_cast<T>(index);
+                    return true;
+                }
+                const auto number = value.get<std::underlying_type_t<T>>();
+                if (number) out = static_cast<T>(number.value);
+                return static_cast<bool>(number);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                const auto number = value.get<T>();
+                if (number) out = number.value;
+                return static_cast<bool>(number);
+            } else if constexpr (std::is_same_v<T, std::string_view>) {
+                out = value.view();
+                return true;
+            } else {
+                out.assign(value.view());
+                return true;
+            }
+        }
+
+        template <typename T>
+        struct is_optional : std::false_type {};
+        template <typename T>
+        struct is_optional<std::optional<T>> : std::true_type {};
+
+        template <typename T>
+        struct is_vector : std::false_type {};
+        template <typename T>
+        struct is_vector<std::vector<T>> : std::true_type {};
+
+        /// writes values to out, leaving out untouched when there are none
+        template <typename T>
+        bool store(T& out, const std::span<const Value> values, const Schema& schema, const std::uint32_t id) {
+            if (values.empty()) return true;
+            if constexpr (is_optional<T>::value) {
+                if (!store(out.emplace(), values, schema, id)) {
+                    out.reset();
+                    return false;
+                }
+                return true;
+            } else if constexpr (is_vector<T>::value) {
+                out.resize(values.size());
+                for (std::size_t i = 0; i < values.size(); i++) {
+                    if (!convert(values[i], out[i], schema, id)) return false;
+                }
+                return true;
+            } else {
+                return convert(values.front(), out, schema, id);
+            }
+        }
+    }
+
+    template <typename T>
+    Binding Binding::to(T& target) noexcept {
+        return {&target, [](void* t, const std::span<const Value> values, const Schema& schema, const std::uint32_t id) {
+            return binding::store(*static_cast<T*>(t), values, schema, id);
+        }};
+    }
+
+    /// @brief One member of an options struct, see Parser::fields().
+    /// @details Declared with a chain like Parser::add_argument(), but every step is constexpr so a table of fields can
+    /// be a compile-time constant. The arity follows from the member's type: a bool is a flag, a std::vector takes one or
+    /// more values and anything else takes exactly one.
+    template <typename S, typename T>
+        requires is_bindable<T>::value
+    class Field {
+        std::string_view _canonical_name;
+        T S::* _member;
+        std::string_view _short_name;
+        std::string_view _description;
+        std::string_view _value_name;
+        std::string_view _default_value;
+        int _min_values = std::is_same_v<T, bool> ? 0 : 1;
+        int _max_values = std::is_same_v<T, bool> ? 0 : binding::is_vector<T>::value ? -1 : 1;
+        bool _required = false;
+
+        friend class Parser;
+
+    public:
+        constexpr Field(const std::string_view name, T S::* member) : _canonical_name(name), _member(member) {}
+
+        constexpr Field& short_name(const std::string_view short_name) {
+            _short_name = short_name;
+            return *this;
+        }
+
+        constexpr Field& help(const std::string_view description) {
+            _description = description;
+            return *this;
+        }
+
+        constexpr Field& value_name(const std::string_view value_name) {
+            _value_name = value_name;
+            return *this;
+        }
+
+        /// written as it would be on the command line, converted like a parsed value
+        constexpr Field& default_value(const std::string_view default_value) {
+            _default_value = default_value;
+            return *this;
+        }
+
+        constexpr Field& required() {
+            _required = true;
+            return *this;
+        }
+
+        /// same rules as Argument::x_value_range(), a bool member is always a flag
+        constexpr Field& x_value_range(const int min_values, const int max_values) {
+            if (std::is_same_v<T, bool> && (min_values != 0 || max_values != 0))
+                throw exceptions::add_argument_error("Flags cannot have min_values or max_values > 0.");
+            if (min_values < 0)
+                throw exceptions::add_argument_error("min_values cannot be negative.");
+            if (!std::is_same_v<T, bool> && max_values <= 0 && max_values != -1)
+                throw exceptions::add_argument_error("max_values must be > 0 or -1 for unlimited.");
+            if (max_values != -1 && min_values > max_values)
+                throw exceptions::add_argument_error("min_values cannot exceed max_values.");
+            _min_values = min_values;
+            _max_values = max_values;
+            return *this;
+        }
+    };
+
+    /// @brief Descriptor table of an options struct S, built with fields().
+    template <typename S, typename... T>
+    struct Fields {
+        std::tuple<Field<S, T>...> fields;
+    };
+
+    /// @brief Describes the options struct S, one Field per member:
+    ///
+    ///     struct Options { int jobs = 1; bool verbose = false; std::vector<std::string> include; };
+    ///
+    ///     constexpr auto options = argcpp::fields(
+    ///         argcpp::Field("jobs", &Options::jobs).short_name("j").default_value("4"),
+    ///         argcpp::Field("verbose", &Options::verbose).short_name("v"),
+    ///         argcpp::Field("include", &Options::include).short_name("I"));
+    template <typename S, typename... T>
+    constexpr Fields<S, T...> fields(const Field<S, T>&... field) {
+        return {{field...}};
+    }
+
+    class Parser {
+        // arguments live in a chunked pool, so references returned by add_argument stay valid and a large schema
+        // costs a handful of allocations. Names are only collected into a lookup table by compile().
+        helper::Stable_Pool<Argument> arguments_;
+
+        // required positionals, comes before optionals
+        std::vector<Positional> required_positionals_;
+
+        // optional positionals, always comes last in the command
+        std::vector<Positional> optional_positionals_;
+
+        int argc_;
+        const char* const* argv_;
+
+        bool response_files_enabled_ = false;
+
+        // variables named <env_prefix_><NAME> feed the argument named name, see env_prefix()
+        std::string env_prefix_;
+
+        struct Config_Source {
+            std::string path;
+            std::string section;
+            bool required;
+        };
+        std::vector<Config_Source> config_sources_;
+
+        // subcommands, each with the callback that builds its parser when it is first dispatched
+        struct Subcommand {
+            std::string name;
+            std::string description;
+            std::function<void(Parser&)> build;
+            std::unique_ptr<Parser> parser;
+        };
+        std::vector<Subcommand> subcommands_;
+        Parser* active_ = nullptr;  // subcommand parser of the last parse
+        std::string program_;       // "<parent> <name>" for a subcommand parser, used in its usage line
+
+        // compiled schema, built once by compile(). After that the schema is frozen.
+        Schema schema_;
+        bool compiled_ = false;
+        bool sources_captured_ = false;
+
+        // result of the last parse() through this parser
+        ParseResult result_;
+
+        // variables written after each successful parse, by argument id, see Argument::bind()
+        std::vector<std::pair<std::uint32_t, Binding>> bindings_;
+        std::vector<Value> tail_values_; // the variadic tail as Values, when it is bound
+
+        // options structs described by fields(), each registered as a run of consecutive argument ids
+        struct Struct_Table {
+            const void* type;                 // &struct_tag<S>, to match a table with parse_into<S>()
+            std::shared_ptr<const void> table; // the Fields<S, T...> passed to fields()
+            std::uint32_t first;              // id of the first field
+            bool (*store)(const void* table, void* object, std::uint32_t first, Parser& parser);
+        };
+        std::vector<Struct_Table> struct_tables_;
+
+        template <typename S>
+        static constexpr char struct_tag = 0;
+
+        // rendered help text per terminal width, see help(). The schema is frozen once compiled, so entries never go
+        // stale, and a deque keeps earlier entries in place as more widths are added.
+        std::deque<std::pair<std::size_t, std::string>> help_cache_;
+
+        template <typename S, typename T>
+        void add_field(const Field<S, T>& field) {
+            Argument& arg = add_argument(std::string(field._canonical_name));
+            if (!field._short_name.empty()) arg.short_name(std::string(field._short_name));
+            if (!field._description.empty()) arg.help(std::string(field._description));
+            if (!field._value_name.empty()) arg.value_name(std::string(field._value_name));
+            if (field._max_values != 0) arg.takes_value().x_value_range(field._min_values, field._max_values);
+            if (!field._default_value.empty() && field._max_values != 1 && field._max_values != 0) {
+                // a list default is split like a list given on the command line
+                Value list(std::vector<Value>{});
+                helper::split(field._default_value, arg._value_delimiter, [&list](const std::string_view piece) {
+                    list.push_back(Value(std::string(piece)));
+                });
+                arg.default_value(list);
+            } else if (!field._default_value.empty()) {
+                arg.default_value(Value(std::string(field._default_value)));
+            }
+            if (field._required) arg.required();
+        }
+
+        /// the values of argument id in the last parse, as one span whatever their origin; empty if it has none
+        std::span<const Value> values_of(const std::uint32_t id) {
+            const Value& value = result_.values_[id];
+            if (id == schema_.variadic_ && !result_.tail_.empty()) {
+                tail_values_.clear();
+                for (const char* text : result_.tail_) tail_values_.emplace_back(std::string_view(text));
+                return tail_values_;
+            }
+            if (value.kind() == Value::Kind::list) return value.list();
+            if (value.has_value()) return {&value, 1};
+            return {};
+        }
+
+        bool fail_conversion(const std::uint32_t id) {
+            return result_.fail("invalid value for argument \"" + schema_.arguments_[id]->_canonical_name + "\"");
+        }
+
+        /// writes the values of bound arguments into their variables, failing the parse on a value that does not convert
+        void store_bindings() {
+            ARGCPP_PHASE(bind);
+            for (const auto& [id, binding] : bindings_) {
+                if (!binding.store(binding.target, values_of(id), schema_, id)) {
+                    fail_conversion(id);
+                    return;
+                }
+            }
+        }
+
+        /// writes field i and the ones after it of table into object
+        template <std::size_t I = 0, typename S, typename... T>
+        bool store_fields(const Fields<S, T...>& table, S& object, const std::uint32_t first) {
+            if constexpr (I == sizeof...(T)) {
+                return true;
+            } else {
+                const auto& field = std::get<I>(table.fields);
+                const auto id = static_cast<std::uint32_t>(first + I);
+                if (!binding::store(object.*field._member, values_of(id), schema_, id)) return fail_conversion(id);
+                return store_fields<I + 1>(table, object, first);
+            }
+        }
+
+        /// @brief Resolves conflicts_with, mandated and requires_one_of to id bitsets in the schema.
+        /// @details mandated is closed transitively, so an argument also requires whatever its requirements require.
+        /// Unknown names and mandated cycles throw add_argument_error.
+        void compile_constraints() {
+            ARGCPP_PHASE(constraints);
+            const std::size_t n = arguments_.size();
+            const std::size_t words = (n + 63) / 64;
+            schema_.words_ = words;
+            schema_.constraint_of_.assign(n, Schema::npos);
+
+            const auto resolve = [this](const Argument& arg, const std::string& name, const char* list) {
+                const std::uint32_t id = schema_.id(name);
+                if (id == Schema::npos) {
+                    throw exceptions::add_argument_error("argument \"" + arg._canonical_name + "\" lists unknown argument \"" + name + "\" in " + list + ".");
+                }
+                return id;
+            };
+            const auto new_set = [this, words] {
+                const auto offset = static_cast<std::uint32_t>(schema_.bits_.size());
+                schema_.bits_.resize(schema_.bits_.size() + words, 0);
+                return offset;
+            };
+            const auto set_bit = [this](const std::uint32_t set, const std::uint32_t id) {
+                schema_.bits_[set + id / 64] |= std::uint64_t{1} << (id % 64);
+            };
+
+            for (const auto& arg : arguments_) {
+                if (arg._conflicts_with.empty() && arg._mandated.empty() && arg._requires_one_of.empty()) continue;
+                Schema::Constraint c;
+                if (!arg._conflicts_with.empty()) {
+                    c.conflicts = new_set();
+                    for (const auto& name : arg._conflicts_with) set_bit(c.conflicts, resolve(arg, name, "conflicts_with"));
+                }
+                if (!arg._requires_one_of.empty()) {
+                    c.one_of = new_set();
+                    for (const auto& name : arg._requires_one_of) set_bit(c.one_of, resolve(arg, name, "requires_one_of"));
+                }
+                if (!arg._mandated.empty()) {
+                    c.mandated = new_set(); // filled by the closure below
+                    for (const auto& name : arg._mandated) resolve(arg, name, "mandated");
+                }
+                schema_.constraint_of_[arg._id] = static_cast<std::uint32_t>(schema_.constraints_.size());
+                schema_.constraints_.push_back(c);
+            }
+
+            // transitive closure of mandated by depth first search; a node met again while still on the stack is a cycle
+            enum class Mark : std::uint8_t { none, active, done };
+            std::vector<Mark> mark(n, Mark::none);
+            std::vector<std::uint32_t> path;
+            const auto close = [&](auto&& self, const std::uint32_t id) -> void {
+                mark[id] = Mark::active;
+                path.push_back(id);
+                const Argument& arg = *schema_.arguments_[id];
+                const std::uint32_t set = schema_.constraints_[schema_.constraint_of_[id]].mandated;
+                for (const auto& name : arg._mandated) {
+                    const std::uint32_t other = schema_.id(name);
+                    if (mark[other] == Mark::active) {
+                        std::string cycle;
+                        for (auto it = std::find(path.begin(), path.end(), other); it != path.end(); ++it) {
+                            cycle += "\"" + schema_.arguments_[*it]->_canonical_name + "\" -> ";
+                        }
+                        throw exceptions::add_argument_error("mandated arguments form a cycle: " + cycle + "\"" + name + "\".");
+                    }
+                    set_bit(set, other);
+                    const std::uint32_t c = schema_.constraint_of_[other];
+                    if (c == Schema::npos || schema_.constraints_[c].mandated == Schema::npos) continue;
+                    if (mark[other] == Mark::none) self(self, other);
+                    const std::uint32_t inner = schema_.constraints_[c].mandated;
+                    for (std::size_t w = 0; w < words; w++) schema_.bits_[set + w] |= schema_.bits_[inner + w];
+                }
+                path.pop_back();
+                mark[id] = Mark::done;
+            };
+            for (const auto& arg : arguments_) {
+                if (mark[arg._id] == Mark::none && !arg._mandated.empty()) close(close, arg._id);
+            }
+        }
+
+        /// @brief Compiles the schema and, the first time it is needed for parsing, captures the environment and maps
+        /// the config files.
+        /// @details Kept out of compile() so that completion, help and introspection never read the environment or
+        /// touch the file system; a missing required config file only fails parsing. Each capture starts from empty
+        /// tables, so one that was interrupted by an exception can simply run again.
+        void capture_sources() {
+            compile();
+            if (sources_captured_) return;
+            compile_environment();
+            compile_config();
+            sources_captured_ = true;
+        }
+
+        /// @brief Captures the environment fallbacks of every argument in one pass over environ.
+        /// @details Variable names go into a perfect hash, so each variable costs one probe however many arguments are
+        /// backed by the environment. With an env_prefix(), a variable such as MYAPP_LOG_LEVEL that no argument names
+        /// explicitly is mapped to the argument named log-level. A flag is set by 1, true, yes or on.
+        void compile_environment() {
+            ARGCPP_PHASE(environment);
+            const auto id_of = [this](const std::string& name) { return schema_.id(name); };
+            std::vector<std::pair<std::string_view, std::uint32_t>> entries;
+            for (const auto& arg : arguments_) {
+                if (!arg._env_var.empty()) entries.emplace_back(arg._env_var, arg._id);
+            }
+            for (const auto& p : required_positionals_) {
+                if (!p.env_var_.empty()) entries.emplace_back(p.env_var_, id_of(p.canonical_name_));
+            }
+            schema_.env_of_.assign(arguments_.size(), Schema::npos);
+            schema_.env_values_.clear();
+
+            const char* const* env = helper::environment();
+            if (!env || (entries.empty() && env_prefix_.empty())) return;
+
+            // a variable named by two arguments feeds the first one
+            std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            entries.erase(std::unique(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), entries.end());
+            const helper::Perfect_Hash names(entries);
+
+            const auto take = [&](const std::uint32_t id, const std::string_view value, const bool explicit_name) {
+                const std::uint32_t slot = schema_.env_of_[id];
+                // an explicit env_var outranks a prefix match for the same argument
+                if (slot != Schema::npos) {
+                    if (explicit_name) schema_.env_values_[slot].value = value;
+                    return;
+                }
+                if (schema_.arguments_[id]->_is_flag && !helper::is_truthy(value)) return;
+                schema_.env_of_[id] = static_cast<std::uint32_t>(schema_.env_values_.size());
+                schema_.env_values_.push_back({id, std::string(value)});
+            };
+
+            std::string mapped;
+            for (; *env; env++) {
+                const std::string_view variable(*env);
+                const std::size_t eq = variable.find('=');
+                if (eq == std::string_view::npos) continue;
+                const std::string_view name = variable.substr(0, eq);
+                const std::string_view value = variable.substr(eq + 1);
+
+                if (const std::uint32_t id = names.find(name); id != Schema::npos) {
+                    take(id, value, true);
+                } else if (!env_prefix_.empty() && name.size() > env_prefix_.size() && name.starts_with(env_prefix_)) {
+                    mapped.assign(name.substr(env_prefix_.size()));
+                    for (char& c : mapped) c = c == '_' ? '-' : helper::fold(c);
+                    if (const std::uint32_t id = schema_.id(mapped); id != Schema::npos) take(id, value, false);
+                }
+            }
+        }
+
+        /// @brief Maps the config files and records the values of the keys that name arguments.
+        /// @details Only the requested section of each file is parsed. Keys are matched against every name of an
+        /// argument; other keys are ignored, so files can be shared with other programs. A later file overrides an
+        /// earlier one. A required file that cannot be read is recorded in the schema and reported by every parse.
+        void compile_config() {
+            ARGCPP_PHASE(config);
+            schema_.config_of_.assign(arguments_.size(), Schema::npos);
+            schema_.config_values_.clear();
+            schema_.config_files_.clear();
+            schema_.source_error_.clear();
+            for (const auto& source : config_sources_) {
+                helper::Mapped_File file(source.path);
+                if (!file.ok()) {
+                    if (source.required && schema_.source_error_.empty()) {
+                        schema_.source_error_ = "cannot read config file \"" + source.path + "\"";
+                    }
+                    continue;
+                }
+                helper::scan_config(file.data(), file.data() + file.size(), source.section, [this](const std::string_view key, const std::string_view value) {
+                    const std::uint32_t id = schema_.id(key);
+                    if (id == Schema::npos) return;
+                    std::uint32_t& slot = schema_.config_of_[id];
+                    if (slot != Schema::npos) {
+                        schema_.config_values_[slot].value = value;
+                        return;
+                    }
+                    slot = static_cast<std::uint32_t>(schema_.config_values_.size());
+                    schema_.config_values_.push_back({id, value});
+                });
+                // the mapping stays where it is when the handle moves, so the views stay valid
+                schema_.config_files_.push_back(std::move(file));
+            }
+        }
+
+        /// parser of subcommand index, built by its callback the first time it is needed
+        Parser& subcommand_parser(const std::uint32_t index) {
+            Subcommand& command = subcommands_[index];
+            if (!command.parser) {
+                auto parser = std::make_unique<Parser>();
+                parser->program_ = std::string(program_name()) + " " + command.name;
+                parser->resource(result_.resource());
+                command.build(*parser);
+                command.parser = std::move(parser);
+            }
+            return *command.parser;
         }
 
-        /// @brief Declares the argument as a flag.
-        /// @details Flags do not accept values and always have min/max values set to 0.
-        Argument& is_flag() {
-            this->_is_flag = true;
-            this->_takes_value = false;
-            this->_min_values = 0;
-            this->_max_values = 0;
-            return *this;
+        /// program name for the usage line, the file name part of argv[0]
+        [[nodiscard]] std::string_view program_name() const noexcept {
+            if (!program_.empty()) return program_;
+            if (argc_ < 1 || !argv_ || !argv_[0]) return "program";
+            std::string_view name(argv_[0]);
+            const std::size_t slash = name.find_last_of("/\\");
+            if (slash != std::string_view::npos) name.remove_prefix(slash + 1);
+            return name.empty() ? "program" : name;
         }
 
-        /// @brief Marks the argument as required for valid invocation.
-        /// @details Absence of this argument during parsing results in an error.
-        Argument& required() {
-            this->_required = true;
-            return *this;
+        /// left column of an option's help entry, e.g. "-o, --output, --out <output>"
+        static std::string help_names(const Argument& arg) {
+            std::string names = arg._short_name.empty() ? "    " : "-" + arg._short_name + ", ";
+            names += "--";
+            names += arg._canonical_name;
+            for (const auto& alias : arg._aliases) {
+                names += ", --";
+                names += alias;
+            }
+            if (arg._takes_value) {
+                names += " <";
+                names += arg._value_name;
+                names += arg._max_values == 1 ? ">" : ">...";
+            }
+            return names;
         }
 
-        Argument& optional();
+        static std::string help_description(const Argument& arg) {
+            std::string text = arg._description;
+            const auto note = [&text](const std::string_view what) {
+                if (!text.empty()) text += ' ';
+                text += what;
+            };
+            if (!arg._allowed_values.empty()) {
+                std::string values = "[possible values:";
+                for (std::size_t i = 0; i < arg._allowed_values.size(); i++) {
+                    values += i ? ", " : " ";
+                    values += arg._allowed_values[i];
+                }
+                note(values + "]");
+            }
+            if (arg._required) note("(required)");
+            if (arg._deprecated) note(arg._deprecated_message.empty() ? "(deprecated)" : "(deprecated: " + arg._deprecated_message + ")");
+            return text;
+        }
 
-        /// @brief Defines a default value that applies when the user does not supply one.
-        /// @details The default is used only if no environment variable or user input overrides it.
-        Argument& default_value(const Value& default_value) {
-            this->_default_value = default_value;
-            return *this;
+        /// appends every candidate in names that starts with prefix to out, one per line, after lead
+        static void append_matches(std::string& out, const std::string_view lead, const std::string_view prefix, const std::vector<std::string>& names) {
+            for (const auto& name : names) {
+                if (!std::string_view(name).starts_with(prefix)) continue;
+                out += lead;
+                out += name;
+                out += '\n';
+            }
         }
 
-        /// @brief Sets both minimum and maximum number of values for the argument.
-        /// @details Flags must always have min/max values of zero. Use -1 for max_values to allow unlimited values.
-        Argument& x_value_range(const int min_values, const int max_values) {
-            if (_is_flag) {
-                if (min_values != 0 || max_values != 0)
-                    throw exceptions::add_argument_error("Flags cannot have min_values or max_values > 0.");
-                _min_values = 0;
-                _max_values = 0;
-                return *this;
+        /// @brief Lays out the whole help text, everything after "usage: <program>", for a terminal of width columns.
+        /// @details Names go in a left column that is as wide as the widest entry up to a third of the terminal. Entries
+        /// with longer names put their description on the next line. Options are grouped by category in the order the
+        /// categories first appear; hidden arguments are left out.
+        std::string render_help(const std::size_t width) {
+            ARGCPP_PHASE(help);
+            struct Entry {
+                std::string names;
+                std::string description;
+                std::string_view category;
+            };
+            std::vector<Entry> positionals;
+            std::vector<Entry> options;
+            std::vector<std::string_view> categories{std::string_view{}};
+
+            std::string out = " [options]";
+            for (std::size_t i = 0; i < schema_.positionals_.size(); i++) {
+                const Argument& arg = *schema_.arguments_[schema_.positionals_[i]];
+                const Positional& p = required_positionals_[i];
+                const std::string& value_name = p.value_name_.empty() ? arg._canonical_name : p.value_name_;
+                out += " <" + value_name + (p.variadic_ ? ">..." : ">");
+                if (!arg._hidden) positionals.push_back({value_name, p.description_.empty() ? arg._description : p.description_, {}});
+            }
+            std::vector<Entry> commands;
+            if (!subcommands_.empty()) {
+                out += " <command> [<args>...]";
+                for (const auto& command : subcommands_) commands.push_back({command.name, command.description, {}});
             }
+            out += '\n';
 
-            if (min_values < 0)
-                throw exceptions::add_argument_error("min_values cannot be negative.");
+            for (const Argument* arg : schema_.arguments_) {
+                if (arg->_hidden || arg->_is_positional) continue;
+                options.push_back({help_names(*arg), help_description(*arg), arg->_category});
+                if (std::find(categories.begin(), categories.end(), arg->_category) == categories.end()) {
+                    categories.push_back(arg->_category);
+                }
+            }
 
-            if (max_values <= 0 && max_values != -1)
-                throw exceptions::add_argument_error("max_values must be > 0 or -1 for unlimited.");
+            constexpr std::size_t indent = 2;
+            constexpr std::size_t gap = 2;
+            std::size_t left = 0;
+            for (const auto* entries : {&positionals, &commands, &options}) {
+                for (const auto& e : *entries) {
+                    if (e.names.size() <= width / 3) left = std::max(left, e.names.size());
+                }
+            }
+            const std::size_t column = indent + left + gap;
+            const std::size_t line_width = std::max(width, column + 20);
+
+            const auto section = [&](const std::string_view title, const std::vector<Entry>& entries, const std::string_view category) {
+                bool empty = true;
+                for (const auto& e : entries) {
+                    if (e.category != category) continue;
+                    if (empty) {
+                        out += '\n';
+                        out += title;
+                        out += ":\n";
+                        empty = false;
+                    }
+                    out.append(indent, ' ');
+                    out += e.names;
+                    if (e.description.empty()) {
+                        out += '\n';
+                        continue;
+                    }
+                    if (indent + e.names.size() + gap > column) {
+                        out += '\n';
+                        out.append(column, ' ');
+                    } else {
+                        out.append(column - indent - e.names.size(), ' ');
+                    }
+                    helper::append_wrapped(out, e.description, column, column, line_width);
+                    out += '\n';
+                }
+            };
+            section("positional arguments", positionals, {});
+            section("commands", commands, {});
+            for (const auto category : categories) {
+                section(category.empty() ? "options" : category, options, category);
+            }
+            return out;
+        }
 
-            if (max_values != -1 && min_values > max_values)
-                throw exceptions::add_argument_error("min_values cannot exceed max_values.");
+        void register_alias(const std::string& alias, const Argument&) const {
+            if (compiled_) {
+                throw exceptions::add_argument_error("cannot add alias \"" + alias + "\", the schema has already been compiled.");
+            }
+        }
 
-            _min_values = min_values;
-            _max_values = max_values;
-            return *this;
+        friend struct Argument;
+
+    public:
+        Parser(const int argc, char** argv)
+            : argc_(argc), argv_(argv)
+        {}
+
+        /// a parser without a command line, for use with parse(std::span)
+        Parser()
+            : argc_(0), argv_(nullptr)
+        {}
+
+        // arguments keep a back-reference to their parser
+        Parser(const Parser&) = delete;
+        Parser& operator=(const Parser&) = delete;
+
+        /// Make argument visible to the parser
+        ///
+        /// @param name would be implicitly used as long name for argument unless set explicitly. Otherwise, it acts as a unique indexing identifier to distinguish between arguments.
+        Argument& add_argument(const std::string &name) {
+            if (compiled_) {
+                throw exceptions::add_argument_error("cannot add argument \"" + name + "\", the schema has already been compiled.");
+            }
+            const auto id = static_cast<std::uint32_t>(arguments_.size());
+            Argument& arg = arguments_.emplace_back();
+            arg.long_name(name);
+            arg._id = id;
+            arg.parser_ = this;
+            return arg;
         }
 
-        /// @brief Restricts acceptable values to the provided set.
-        /// @details The parser rejects input not contained in this list.
-        Argument& allowed_values(const std::vector<std::string> &allowed_values) {
-            this->_allowed_values = allowed_values;
+        /// @brief Adds one argument per field of an options struct, see argcpp::fields().
+        /// @details The arguments behave like any other, so get() and the help text see them too. parse_into() then
+        /// writes a whole struct at once, each field straight from its argument's slot.
+        template <typename S, typename... T>
+        Parser& fields(const Fields<S, T...>& table) {
+            const auto first = static_cast<std::uint32_t>(arguments_.size());
+            std::apply([this](const auto&... field) {
+                (add_field(field), ...);
+            }, table.fields);
+            struct_tables_.push_back({&struct_tag<S>, std::make_shared<const Fields<S, T...>>(table), first,
+                [](const void* t, void* object, const std::uint32_t first, Parser& parser) {
+                    return parser.store_fields(*static_cast<const Fields<S, T...>*>(t), *static_cast<S*>(object), first);
+                }});
             return *this;
         }
 
-        /// @brief Assigns a custom validation predicate for argument values.
-        /// @details The function must return true to indicate validity.
-        Argument& validate(const std::function<bool(const std::string&)>& validator) {
-            this->_validator = validator;
-            return *this;
+        /// @brief Parses the command line and fills object from every table registered for S with fields().
+        /// @details Fields whose argument was neither given nor defaulted keep the value object already had.
+        /// @return ok(); on failure the error and help have been displayed, as with parse()
+        template <typename S>
+        bool parse_into(S& object) {
+            parse();
+            if (!result_.ok()) return false;
+            ARGCPP_PHASE(bind);
+            bool found = false;
+            for (const Struct_Table& t : struct_tables_) {
+                if (t.type != &struct_tag<S>) continue;
+                found = true;
+                if (!t.store(t.table.get(), &object, t.first, *this)) {
+                    display_help(result_.error());
+                    return false;
+                }
+            }
+            if (!found) {
+                throw exceptions::add_argument_error("no fields() table describes the struct passed to parse_into().");
+            }
+            return ok();
         }
 
-        /// @brief Sets the error message shown when validation fails.
-        /// @details Should guide the user toward acceptable input.
-        Argument& validation_error_message(const std::string& error_message) {
-            this->_validation_error = error_message;
-            return *this;
+        /// Freezes the schema and builds the lookup table over every canonical name, short name and alias.
+        ///
+        /// Called implicitly by parse() and schema(). Once compiled, adding arguments or aliases throws add_argument_error.
+        void compile() {
+            if (compiled_) return;
+            ARGCPP_PHASE(compile);
+
+            std::vector<std::pair<std::string_view, std::uint32_t>> entries;
+            entries.reserve(arguments_.size() * 2);
+            for (const auto& arg : arguments_) {
+                entries.emplace_back(arg._canonical_name, arg._id);
+                if (!arg._short_name.empty()) entries.emplace_back(arg._short_name, arg._id);
+                for (const auto& alias : arg._aliases) {
+                    entries.emplace_back(alias, arg._id);
+                }
+            }
+
+            // a name registered twice would leave the lookup ambiguous
+            std::sort(entries.begin(), entries.end());
+            for (std::size_t i = 1; i < entries.size(); i++) {
+                if (entries[i].first == entries[i - 1].first && entries[i].second != entries[i - 1].second) {
+                    throw exceptions::add_argument_error("the name \"" + std::string(entries[i].first) + "\" is used by more than one argument.");
+                }
+            }
+            entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+            schema_.lookup_ = helper::Perfect_Hash(entries);
+
+            schema_.arguments_.reserve(arguments_.size());
+            for (auto& arg : arguments_) {
+                schema_.arguments_.push_back(&arg);
+                if (arg._required && !arg._is_positional) schema_.required_.push_back(arg._id);
+            }
+            for (const auto& p : required_positionals_) {
+                const std::uint32_t id = schema_.id(p.canonical_name_);
+                if (id == Schema::npos) {
+                    throw exceptions::add_argument_error("positional \"" + p.canonical_name_ + "\" does not name an argument.");
+                }
+                schema_.positionals_.push_back(id);
+                if (p.validator_) {
+                    arguments_[id]._validator = p.validator_;
+                    arguments_[id]._validation_error = p.validation_error_;
+                }
+                if (p.variadic_) {
+                    if (&p != &required_positionals_.back()) {
+                        throw exceptions::add_argument_error("only the last positional can be variadic, \"" + p.canonical_name_ + "\" is not last.");
+                    }
+                    schema_.variadic_ = id;
+                    schema_.variadic_min_ = p.required_ ? static_cast<std::size_t>(std::max(p.min_values_, 1)) : 0;
+                }
+            }
+            for (const auto& arg : arguments_) {
+                if (arg._binding) bindings_.emplace_back(arg._id, arg._binding);
+            }
+            for (std::size_t i = 0; i < required_positionals_.size(); i++) {
+                if (required_positionals_[i].binding_) bindings_.emplace_back(schema_.positionals_[i], required_positionals_[i].binding_);
+            }
+
+            // allowed values become hashed sets, so a value is checked with one probe however many choices there are
+            schema_.choice_of_.assign(arguments_.size(), Schema::npos);
+            const auto add_choices = [this](const std::uint32_t id, const std::vector<std::string>& choices, const bool case_sensitive) {
+                if (choices.empty()) return;
+                schema_.choice_of_[id] = static_cast<std::uint32_t>(schema_.choices_.size());
+                schema_.choices_.emplace_back(choices, case_sensitive);
+            };
+            for (const auto& arg : arguments_) {
+                add_choices(arg._id, arg._allowed_values, arg._case_sensitive);
+            }
+            for (std::size_t i = 0; i < required_positionals_.size(); i++) {
+                add_choices(schema_.positionals_[i], required_positionals_[i].allowed_values_, required_positionals_[i].case_sensitive_);
+            }
+            compile_constraints();
+            // the environment and config files are only read on the first parse, see capture_sources()
+            schema_.env_of_.assign(arguments_.size(), Schema::npos);
+            schema_.config_of_.assign(arguments_.size(), Schema::npos);
+
+            std::vector<std::string> commands;
+            commands.reserve(subcommands_.size());
+            for (const auto& command : subcommands_) {
+                if (std::find(commands.begin(), commands.end(), command.name) != commands.end()) {
+                    throw exceptions::add_argument_error("the subcommand \"" + command.name + "\" is added more than once.");
+                }
+                commands.push_back(command.name);
+            }
+            schema_.commands_ = helper::Trie(std::move(commands));
+            schema_.response_files_ = response_files_enabled_;
+
+            result_.bind(schema_);
+            compiled_ = true;
         }
 
-        /// @brief Specifies arguments that cannot appear alongside this one.
-        /// @details Enforces mutual exclusivity.
-        Argument& conflicts_with(const std::vector<std::string> &conflicts_with) {
-            this->_conflicts_with = conflicts_with;
-            return *this;
+        [[nodiscard]] bool compiled() const noexcept {
+            return compiled_;
         }
 
-        /// @brief Specifies arguments that must also be present when this argument is used.
-        /// @details Implements strict dependency enforcement.
-        Argument& mandated(const std::vector<std::string> &mandated) {
-            this->_mandated = mandated;
-            return *this;
+        /// @brief The compiled schema, compiling it first if needed. Share it between threads to parse concurrently.
+        /// @details The first call, like the first parse(), also captures the environment and maps the config files;
+        /// later changes to either are not seen.
+        const Schema& schema() {
+            capture_sources();
+            return schema_;
         }
 
-        /// @brief Ensures that at least one argument from the given list is present.
-        /// @details Useful for alternatives such as (--tcp | --udp).
-        Argument& requires_one_of(const std::vector<std::string> &requires_one_of) {
-            this->_requires_one_of = requires_one_of;
+        /// @brief Makes parse() allocate from resource, see ParseResult(std::pmr::memory_resource*).
+        /// @details Discards the result of the last parse. Subcommand parsers use the same resource. The schema is
+        /// built once and never allocates while parsing, so it keeps using the global heap.
+        Parser& resource(std::pmr::memory_resource* resource) {
+            std::destroy_at(&result_);
+            std::construct_at(&result_, resource);
+            for (auto& command : subcommands_) {
+                if (command.parser) command.parser->resource(resource);
+            }
             return *this;
         }
 
-        /// @brief Assigns a positional index to the argument.
-        /// @details Zero indicates a non-positional (named) argument.
-        /// @return Reference to the created/inserted Positional object.
-        Positional& position(const int position);
+        /// @brief Per-phase timings of the calling thread, see Profile.
+        /// @details Stays empty unless the header is compiled with ARGCPP_INSTRUMENT=1. Compiling, parsing and help
+        /// rendering through any parser on this thread record into the same profile.
+        [[nodiscard]] static Profile& profile() {
+            return argcpp::profile();
+        }
 
-        /// @brief Hides the argument from help output.
-        /// @details Used for deprecated or private options.
-        Argument& hidden() {
-            this->_hidden = true;
-            return *this;
+        /// result of the last parse()
+        [[nodiscard]] const ParseResult& result() const noexcept {
+            return result_;
         }
 
-        /// @brief Marks the argument as deprecated.
-        /// @details The parser may emit warnings when this argument is used.
-        Argument& deprecated() {
-            this->_deprecated = true;
-            return *this;
+        /// @brief Help text for a terminal of width columns, without the leading "usage: <program>".
+        /// @details Rendered once per width into one buffer and cached; 0 picks the width of the terminal on stdout.
+        /// The view stays valid for the parser's lifetime.
+        std::string_view help(std::size_t width = 0) {
+            compile();
+            if (width == 0) width = helper::terminal_width();
+            for (const auto& [w, text] : help_cache_) {
+                if (w == width) return text;
+            }
+            return help_cache_.emplace_back(width, render_help(width)).second;
         }
 
-        /// @brief Provides a guidance message when the deprecated argument is used.
-        /// @details Should indicate the recommended replacement argument.
-        Argument& deprecated_message(const std::string& deprecated_message) {
-            this->_deprecated_message = deprecated_message;
+        /// @brief Completion candidates for words[cword], one per line.
+        /// @details words is the command line as the shell split it, words[0] being the program, and cword may equal
+        /// words.size() when a new word is started. Like parse(), the first words fill the positionals and the rest are
+        /// options. Candidates are option names, aliases and subcommands, or the allowed values of the option or
+        /// positional the word belongs to; after a subcommand word the subcommand's parser answers. An empty result lets
+        /// the shell fall back to file names. Only the compiled lookup table is used: no help text is built, no
+        /// environment variable is read and no validator runs.
+        std::string complete(const std::span<const char* const> words, const std::size_t cword) {
+            compile();
+            std::string out;
+            const std::size_t end = std::min(cword, words.size());
+            std::string_view current = cword < words.size() ? std::string_view(words[cword]) : std::string_view{};
+
+            // a positional slot
+            if (cword >= 1 && cword - 1 < schema_.positionals_.size()) {
+                append_matches(out, "", current, required_positionals_[cword - 1].allowed_values_);
+                return out;
+            }
+
+            // replay the options before the word to learn whether it is a value of one of them
+            const Argument* pending = nullptr;
+            std::size_t count = 0;
+            for (std::size_t i = 1 + schema_.positionals_.size(); i < end; i++) {
+                std::string_view token = words[i];
+                if (token == "=" && pending) continue; // bash splits --name=value at the '='
+                if (Schema::is_option(token)) {
+                    Schema::remove_prefix(token);
+                    const std::size_t eq = token.find('=');
+                    pending = schema_.find(token.substr(0, eq));
+                    count = eq == std::string_view::npos ? 0 : 1;
+                    if (pending && pending->_is_flag) pending = nullptr;
+                } else if (pending) {
+                    count++;
+                } else if (const std::uint32_t command = schema_.commands_.find(token); command != helper::Trie::npos) {
+                    // the rest of the line belongs to the subcommand
+                    return subcommand_parser(command).complete(words.subspan(i), cword - i);
+                }
+                if (pending && pending->_max_values != -1 && count >= static_cast<std::size_t>(pending->_max_values)) pending = nullptr;
+            }
+            if (current == "=") current = {};
+
+            // --name=prefix
+            if (Schema::is_option(current) && current.find('=') != std::string_view::npos) {
+                const std::size_t eq = current.find('=');
+                std::string_view name = current.substr(0, eq);
+                Schema::remove_prefix(name);
+                if (const Argument* arg = schema_.find(name)) {
+                    append_matches(out, current.substr(0, eq + 1), current.substr(eq + 1), arg->_allowed_values);
+                }
+                return out;
+            }
+
+            if (pending && (!Schema::is_option(current) || pending->_allow_hyphen_values)) {
+                append_matches(out, "", current, pending->_allowed_values);
+                if (count < static_cast<std::size_t>(pending->_min_values) || !out.empty()) return out;
+            }
+
+            if (!Schema::is_option(current)) {
+                schema_.commands_.for_each_prefixed(current, [&out](const std::string_view command, std::uint32_t) {
+                    out += command;
+                    out += '\n';
+                });
+            }
+            if (current.empty() || current.front() == '-') {
+                for (const Argument* arg : schema_.arguments_) {
+                    if (arg->_hidden || arg->_is_positional) continue;
+                    const auto offer = [&](const std::string_view dashes, const std::string_view name) {
+                        if (name.empty()) return;
+                        const std::size_t mark = out.size();
+                        out += dashes;
+                        out += name;
+                        if (std::string_view(out).substr(mark).starts_with(current)) out += '\n';
+                        else out.resize(mark);
+                    };
+                    offer("--", arg->_canonical_name);
+                    for (const auto& alias : arg->_aliases) offer("--", alias);
+                    offer("-", arg->_short_name);
+                }
+            }
+            return out;
+        }
+
+        /// @brief Shell code that makes the shell complete this program's arguments, by calling it with --__complete.
+        /// @details Load it with, for example, `source <(prog --completion bash)` after printing it from such an option.
+        /// The program answers the script's calls with handle_completion().
+        std::string completion_script(const Shell shell) const {
+            const std::string program(program_name());
+            std::string function = "_" + program + "_complete";
+            for (char& c : function) {
+                if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+            }
+
+            switch (shell) {
+                case Shell::bash:
+                    return function + "() {\n"
+                        "    local IFS=$'\\n'\n"
+                        "    COMPREPLY=($(\"${COMP_WORDS[0]}\" --__complete \"$COMP_CWORD\" \"${COMP_WORDS[@]}\" 2>/dev/null))\n"
+                        "}\n"
+                        "complete -o default -F " + function + " " + program + "\n";
+                case Shell::zsh:
+                    return function + "() {\n"
+                        "    local -a candidates\n"
+                        "    candidates=(\"${(@f)$(\"${words[1]}\" --__complete $((CURRENT - 1)) \"${words[@]}\" 2>/dev/null)}\")\n"
+                        "    if [[ -n \"${candidates[1]}\" ]]; then\n"
+                        "        compadd -Q -- \"${candidates[@]}\"\n"
+                        "    else\n"
+                        "        _files\n"
+                        "    fi\n"
+                        "}\n"
+                        "compdef " + function + " " + program + "\n";
+                case Shell::fish:
+                    return "function " + function + "\n"
+                        "    set -l words (commandline -opc)\n"
+                        "    $words[1] --__complete (count $words) $words (commandline -ct) 2>/dev/null\n"
+                        "end\n"
+                        "complete -c " + program + " -a '(" + function + ")'\n";
+            }
+            return {};
+        }
+
+        /// @brief Prints the usage and help text with a single write.
+        /// @details With a condition message the output goes to stderr, prefixed by "error: <message>", otherwise to stdout.
+        void display_help(
+            const std::string_view condition_message = "" // A helpful message to display alongside the help, empty for no message
+        ) {
+            const std::string_view text = help();
+            const bool error = !condition_message.empty();
+            helper::write_out(error, {
+                error ? "error: " : "", condition_message, error ? "\n\n" : "",
+                "usage: ", program_name(), text
+            });
+        }
+
+        /// @brief Value of an argument after parse(), looked up by any of its names.
+        /// @details Text values are views into argv; convert with std::string(...) for an owning copy.
+        const Value& get(const std::string_view name) const {
+            return result_.get(name);
+        }
+
+        /// whether the argument was given on the command line, through its environment variable or in a config file
+        bool provided(const std::string_view name) const {
+            return result_.provided(name);
+        }
+
+        /// @brief Values of the variadic positional after parse(), without a copy per value.
+        /// @details Use Tail::strings() for owning copies that outlive argv.
+        Tail tail(const std::string_view name) const {
+            return result_.tail(name);
+        }
+
+        /// @brief Expands @path tokens into the whitespace separated tokens of the file at path.
+        /// @details Response files may include further response files. They are memory-mapped and tokenized lazily while
+        /// parsing, so even very large files cost little more than their mapping.
+        Parser& response_files(const bool enabled = true) {
+            if (compiled_) {
+                throw exceptions::add_argument_error("cannot change response file handling, the schema has already been compiled.");
+            }
+            response_files_enabled_ = enabled;
             return *this;
         }
 
-        /// @brief Sets the delimiter used to split a single value into multiple entries.
-        /// @details Useful for comma-separated lists or path variables.
-        Argument& value_delimiter(const char delimiter) {
-            this->_value_delimiter = delimiter;
+        /// @brief Lets variables named <prefix><NAME> supply arguments without an explicit env_var.
+        /// @details The rest of the variable name is lower-cased and '_' becomes '-', so with the prefix "MYAPP_" the
+        /// variable MYAPP_LOG_LEVEL feeds the argument named log-level. Explicit env_var() names take precedence.
+        Parser& env_prefix(const std::string& prefix) {
+            if (compiled_) {
+                throw exceptions::add_argument_error("cannot set the environment prefix, the schema has already been compiled.");
+            }
+            env_prefix_ = prefix;
             return *this;
         }
 
-        /// @brief Allows values that begin with a hyphen.
-        /// @details Required for negative numbers and file names such as "-foo".
-        Argument& allow_hyphen_value(const bool allow_hyphen_value) {
-            this->_allow_hyphen_values = allow_hyphen_value;
+        /// @brief Registers a subcommand, as in `tool [options] <name> [subcommand arguments]`.
+        /// @details build receives an empty parser and declares the subcommand's arguments, which may include further
+        /// subcommands. It only runs when the subcommand is dispatched, so a tool with many subcommands pays for the
+        /// one being run. Subcommand words are matched through a trie once the options of this parser have been read.
+        template <typename F>
+            requires std::invocable<F&, Parser&>
+        Parser& add_subcommand(const std::string& name, F&& build, const std::string& description = "") {
+            if (compiled_) {
+                throw exceptions::add_argument_error("cannot add subcommand \"" + name + "\", the schema has already been compiled.");
+            }
+            subcommands_.push_back({name, description, std::forward<F>(build), nullptr});
             return *this;
         }
 
-        /// @brief Specifies an environment variable to use when no argument value is provided.
-        /// @details Useful for configuration defaults and secret propagation (e.g., tokens).
-        Argument& env_var(const std::string &env_var) {
-            this->_env_var = env_var;
+        /// the parser of the subcommand dispatched by the last parse(), nullptr if none was given
+        [[nodiscard]] Parser* subcommand() const noexcept {
+            return active_;
+        }
+
+        /// name of the subcommand dispatched by the last parse(), empty if none was given
+        [[nodiscard]] std::string_view subcommand_name() const noexcept {
+            return active_ ? std::string_view(subcommands_[result_.subcommand()].name) : std::string_view{};
+        }
+
+        /// @brief Adds an INI/TOML-like file as a source of values below the environment and above the defaults.
+        /// @details Values are resolved in the order command line, environment, config files, default value; among
+        /// config files a later one wins. Only the lines of [section] are read (the lines before the first header when
+        /// section is empty), keys are argument names and values follow the command line rules for splitting and
+        /// allowed values. The file is memory-mapped on the first parse and sections that are not asked for are skipped
+        /// without being parsed. A missing file is ignored unless required is set, in which case every parse fails with
+        /// an error naming the file; completion and help never open it. See ParseResult::source() for where a value
+        /// came from.
+        Parser& config_file(const std::string& path, const std::string& section = "", const bool required = false) {
+            if (compiled_) {
+                throw exceptions::add_argument_error("cannot add config file \"" + path + "\", the schema has already been compiled.");
+            }
+            config_sources_.push_back({path, section, required});
             return *this;
         }
 
-        friend class Parser;
-    };
+        /// false if the last parse() reported an error, here or in the dispatched subcommand
+        [[nodiscard]] bool ok() const noexcept {
+            return result_.ok() && (!active_ || active_->ok());
+        }
+
+        /// @brief Clears the state of the last parse so the parser can take another command line.
+        /// @details Costs O(number of arguments the last parse touched). Collected value lists keep their capacity.
+        /// Views returned by get() for the previous command line must not be used afterwards.
+        void reset() {
+            result_.reset();
+            if (active_) active_->reset();
+            active_ = nullptr;
+        }
+
+        /// @brief Parses another command line against the same schema.
+        /// @details args has the layout of main's argv, args[0] being the program name. Resets the previous parse first.
+        /// The strings in args have to outlive the results.
+        void parse(const std::span<const char* const> args) {
+            argc_ = static_cast<int>(args.size());
+            argv_ = args.data();
+            parse();
+        }
+
+        /// @brief Answers a command line of the form `prog --__complete <cword> <words...>`, as sent by the scripts of
+        /// completion_script(), by writing complete(words, cword) to out.
+        /// @details Opt-in and separate from parse(), which treats --__complete like any other unknown option. Call it
+        /// first thing in main:
+        ///
+        ///     if (parser.handle_completion(argc, argv, std::cout)) return 0;
+        /// @return true if argv was a completion request and has been answered; false otherwise, including when cword
+        /// is not a number
+        bool handle_completion(const int argc, const char* const* argv, std::ostream& out) {
+            if (argc < 3 || std::string_view(argv[1]) != "--__complete") return false;
+            std::size_t cword = 0;
+            const std::string_view text(argv[2]);
+            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), cword);
+            if (ec != std::errc{} || end != text.data() + text.size()) return false;
+            out << complete({argv + 3, static_cast<std::size_t>(argc - 3)}, cword);
+            out.flush();
+            return true;
+        }
+
+        /// @brief Parses the command line given at construction or by the last parse(std::span).
+        void parse() {
+            capture_sources();
+            schema_.parse({argv_, static_cast<std::size_t>(argc_)}, result_);
+            active_ = nullptr;
+            if (result_.ok()) store_bindings();
+            if (!result_.ok()) {
+                display_help(result_.error());
+                return;
+            }
+            if (result_.subcommand() != ParseResult::npos) {
+                active_ = &subcommand_parser(result_.subcommand());
+                active_->parse(result_.subcommand_args());
+            }
+        }
+
+        /// @brief Parses many command lines in parallel against this parser's schema, see Schema::parse_batch().
+        template <std::ranges::random_access_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<const R&>, std::span<const char* const>>
+        [[nodiscard]] std::vector<ParseResult> parse_batch(const R& commands, const unsigned threads = 0,
+                                                           std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+            capture_sources();
+            return schema_.parse_batch(commands, threads, resource);
+        }
+
+    };
+
+    inline Argument& Argument::short_name(const std::string &short_name) {
+        if (parser_) parser_->register_alias(short_name, *this);
+        this->_short_name = short_name;
+        return *this;
+    }
+
+    inline Argument& Argument::aliases(const std::vector<std::string> &alias_list) {
+        for (auto &alias : alias_list) {
+            if (parser_) parser_->register_alias(alias, *this);
+        }
+        this->_aliases = alias_list;
+        return *this;
+    }
+
+    inline Positional& Argument::position(const int position) {
+        if (position < 1) {
+            throw exceptions::add_argument_error("positional arguments must have positions starting at 1.");
+        }
+
+        _is_flag = false;
+        _takes_value = false;
+        _required = true;
+        _is_positional = true;
+
+        // add positional argument to vector
+        if (parser_) {
+            Positional p;
+            p.canonical_name_ = this->_canonical_name;
+            helper::push_back_and_replace(parser_->required_positionals_, position - 1, p);
+            this->_position = position;
+            // Return reference to the inserted/updated Positional
+            return parser_->required_positionals_[position - 1];
+        } else {
+            throw exceptions::add_argument_error("No parser associated with this Argument for position().");
+        }
+    }
+
+    inline Argument &Argument::optional() {
+        // if there exists a parser object and `this` is positional,
+        // then we remove the last index of required_positionals and
+        // move it to optional_positionals
+        if (parser_ && this->_is_positional) {
+            const Positional p = parser_->required_positionals_[parser_->optional_positionals_.size() - 1];
+            parser_->optional_positionals_.push_back(p);
+            parser_->required_positionals_.pop_back();
+        }
+        this->_required = false;
+
 
-    struct Positional {
-        // --- identity ---
-        std::string canonical_name_;      // internal name used by Parser
-        std::string value_name_;          // shown in help text (e.g., FILE, PATH)
+        return *this;
+    }
 
-        // --- metadata ---
-        std::string description_;         // human-readable explanation
 
-        // --- positional semantics ---
-        int position_index_ = 0;          // 0-based physical order
-        bool required_ = true;            // required unless declared optional
-        bool variadic_ = false;           // whether it consumes unlimited remaining args
+    // ---- compile-time schemas ----
+
+    /// @brief One argument of a Static_Schema, declared with the same chain as Parser::add_argument() but evaluated by the
+    /// compiler.
+    /// @details Lists of names or values are written as a single '|' separated string, e.g. allowed_values("fast|slow"),
+    /// so a whole declaration is a literal type. Mistakes that Parser reports with add_argument_error, such as an
+    /// invalid value range, make the declaration fail to compile.
+    class Static_Argument {
+        std::string_view _canonical_name;
+        std::string_view _short_name;
+        std::string_view _aliases;         // '|' separated
+        std::string_view _description;
+        std::string_view _value_name;
+        std::string_view _default_value;
+        std::string_view _allowed_values;  // '|' separated
+        std::string_view _conflicts_with;  // '|' separated
+        std::string_view _mandated;        // '|' separated
+        std::string_view _requires_one_of; // '|' separated
+        int _min_values = 0;
+        int _max_values = 0;
+        int _position = 0;
+        bool _takes_value = false;
+        bool _is_flag = true;
+        bool _required = false;
+        bool _hidden = false;
 
-        // --- values ---
-        int min_values_ = 1;              // usually 1 for simple positionals
-        int max_values_ = 1;              // -1 for unlimited (only allowed for last positional)
-        Value default_value_;              // default if omitted AND optional
-        std::vector<Value> values_;        // collected values after parsing
+        template <typename Spec>
+        friend class Static_Schema;
 
-        // --- validation ---
-        std::vector<std::string> allowed_values_;
-        std::function<bool(const std::string&)> validator_;
-        std::string validation_error_;
+    public:
+        constexpr explicit Static_Argument(const std::string_view name) : _canonical_name(name), _value_name(name) {}
 
-        // --- formatting ---
-        char value_delimiter_ = ',';      // allows “a,b,c” as value lists
+        constexpr Static_Argument& short_name(const std::string_view short_name) {
+            _short_name = short_name;
+            return *this;
+        }
 
-        // --- environment integration ---
-        std::string env_var_;             // optional: fallback source
+        constexpr Static_Argument& aliases(const std::string_view alias_list) {
+            _aliases = alias_list;
+            return *this;
+        }
 
-        // --- parser bookkeeping ---
-        bool was_provided_ = false;       // track whether user gave it
+        constexpr Static_Argument& help(const std::string_view description) {
+            _description = description;
+            return *this;
+        }
 
-        // --- builder-style member functions ---
-        Positional& help(const std::string& description) {
-            this->description_ = description;
+        constexpr Static_Argument& value_name(const std::string_view value_name) {
+            _value_name = value_name;
             return *this;
         }
 
-        Positional& name(const std::string& name) {
-            this->canonical_name_ = name;
-            this->value_name_ = name;
+        constexpr Static_Argument& default_value(const std::string_view default_value) {
+            _default_value = default_value;
             return *this;
         }
 
-        Positional& value_name(const std::string& value_name) {
-            this->value_name_ = value_name;
+        constexpr Static_Argument& takes_value() {
+            _takes_value = true;
+            _is_flag = false;
+            if (_min_values == 0) _min_values = 1;
+            if (_max_values == 0) _max_values = 1;
             return *this;
         }
-        Positional& default_value(const Value& default_value) {
-            this->default_value_ = default_value;
+
+        constexpr Static_Argument& flag() {
+            _takes_value = false;
+            _is_flag = true;
+            _min_values = 0;
+            _max_values = 0;
             return *this;
         }
-        Positional& allowed_values(const std::vector<std::string>& allowed_values) {
-            this->allowed_values_ = allowed_values;
+
+        constexpr Static_Argument& required() {
+            _required = true;
             return *this;
         }
-        Positional& validate(const std::function<bool(const std::string&)>& validator) {
-            this->validator_ = validator;
+
+        constexpr Static_Argument& optional() {
+            _required = false;
             return *this;
         }
-        Positional& validation_error_message(const std::string& error_message) {
-            this->validation_error_ = error_message;
+
+        /// same rules as Argument::x_value_range()
+        constexpr Static_Argument& x_value_range(const int min_values, const int max_values) {
+            if (_is_flag && (min_values != 0 || max_values != 0))
+                throw exceptions::add_argument_error("Flags cannot have min_values or max_values > 0.");
+            if (min_values < 0)
+                throw exceptions::add_argument_error("min_values cannot be negative.");
+            if (!_is_flag && max_values <= 0 && max_values != -1)
+                throw exceptions::add_argument_error("max_values must be > 0 or -1 for unlimited.");
+            if (max_values != -1 && min_values > max_values)
+                throw exceptions::add_argument_error("min_values cannot exceed max_values.");
+            _min_values = min_values;
+            _max_values = max_values;
             return *this;
         }
-        Positional& value_delimiter(const char delimiter) {
-            this->value_delimiter_ = delimiter;
+
+        /// 1-based position among the positionals, which come before the options like with Parser
+        constexpr Static_Argument& position(const int position) {
+            if (position < 1)
+                throw exceptions::add_argument_error("positional arguments must have positions starting at 1.");
+            _position = position;
+            _is_flag = false;
+            _takes_value = false;
+            _required = true;
             return *this;
         }
-        Positional& env_var(const std::string& env_var) {
-            this->env_var_ = env_var;
+
+        constexpr Static_Argument& allowed_values(const std::string_view values) {
+            _allowed_values = values;
             return *this;
         }
-        Positional& required() {
-            this->required_ = true;
+
+        constexpr Static_Argument& conflicts_with(const std::string_view names) {
+            _conflicts_with = names;
             return *this;
         }
-        Positional& optional() {
-            this->required_ = false;
+
+        constexpr Static_Argument& mandated(const std::string_view names) {
+            _mandated = names;
             return *this;
         }
-        // Positional& min_values(int minval) {
-        //     this->min_values_ = minval;
-        //     return *this;
-        // }
-        // Positional& max_values(int maxval) {
-        //     this->max_values_ = maxval;
-        //     return *this;
-        // }
 
-        // TODO make this one range function ^
-        Positional& position_index(int idx) {
-            this->position_index_ = idx;
+        constexpr Static_Argument& requires_one_of(const std::string_view names) {
+            _requires_one_of = names;
             return *this;
         }
-        Positional& variadic(bool is_variadic = true) {
-            this->variadic_ = is_variadic;
+
+        constexpr Static_Argument& hidden() {
+            _hidden = true;
             return *this;
         }
     };
 
-    class Parser {
-        std::unordered_map<std::string, std::shared_ptr<Argument>> argument_map_;
-        std::vector<std::shared_ptr<Argument>> arguments_;
-
-        // required positionals, comes before optionals
-        std::vector<Positional> required_positionals_;
+    /// @brief Outcome of parsing one command line against a Static_Schema with N arguments.
+    /// @details Fixed size and allocation free unless the parse fails. Values are views into argv; the values of a
+    /// list argument are the consecutive argv entries that followed its name.
+    template <std::size_t N>
+    class Static_Result {
+        std::array<std::string_view, N> values_{};
+        std::array<std::uint32_t, N> list_begin_{}; // index into args_ of the first value of a list
+        std::array<std::uint32_t, N> list_size_{};
+        std::array<std::uint64_t, (N + 63) / 64> provided_{};
+        std::array<std::uint64_t, (N + 63) / 64> lists_{}; // list arguments that were given
+        std::span<const char* const> args_;
+        std::string error_;
+        bool ok_ = true;
+
+        bool fail(std::string message) {
+            if (ok_) error_ = std::move(message);
+            ok_ = false;
+            return false;
+        }
 
-        // optional positionals, always comes last in the command
-        std::vector<Positional> optional_positionals_;
+        template <typename Spec>
+        friend class Static_Schema;
 
+    public:
+        [[nodiscard]] bool ok() const noexcept {
+            return ok_;
+        }
 
-        // results
-        std::unordered_map<std::string, Value> results_;
+        explicit operator bool() const noexcept {
+            return ok_;
+        }
 
-        int argc_;
-        char **argv_;
+        [[nodiscard]] const std::string& error() const noexcept {
+            return error_;
+        }
 
-        // members for iteration counts, program specified values, users don't specify these
-        std::size_t argv_index;
+        [[nodiscard]] bool provided(const std::uint32_t id) const noexcept {
+            return (provided_[id / 64] >> (id % 64)) & 1;
+        }
 
-        std::string next() {
-            return argv_[argv_index++];
+        /// the value of a single valued argument, its default when it was not given
+        [[nodiscard]] std::string_view value(const std::uint32_t id) const noexcept {
+            return values_[id];
         }
 
-        void register_alias(const std::string& alias, const Argument& arg) {
-            argument_map_[alias] = argument_map_.at(arg._canonical_name);
+        /// the values of a list argument
+        [[nodiscard]] std::span<const char* const> values(const std::uint32_t id) const noexcept {
+            return args_.subspan(list_begin_[id], list_size_[id]);
         }
 
-        static void remove_prefix(std::string& str) {
-            if (str.starts_with("-")) {
-                str.erase(0, 1);
-            } else if (str.starts_with("--")) {
-                str.erase(0, 2);
+        /// @brief The value as a Value, for typed access through Value::get<T>().
+        /// @details Flags give a boolean, list arguments a list of views into argv, other arguments a view of their
+        /// value, or an empty Value when there is none.
+        [[nodiscard]] Value get(const std::uint32_t id) const {
+            if ((lists_[id / 64] >> (id % 64)) & 1) {
+                Value list;
+                list.reserve(list_size_[id]);
+                for (const char* value : values(id)) list.push_back(std::string_view(value));
+                return list;
             }
+            if (!values_[id].data()) return provided(id) ? Value(true) : Value();
+            return Value(values_[id]);
         }
+    };
 
-        void parse_positional_arguments() {
-            // if empty then do nothing
-            if (optional_positionals_.empty() && required_positionals_.empty()) {
-                return;
+    /// @brief A schema that the compiler builds: name lookup, help text and constraint bitsets are constants in the
+    /// binary, so using it costs no construction at startup.
+    /// @details Spec is a captureless lambda returning a std::array of Static_Argument, see make_static_schema(). The
+    /// parse rules follow Parser: positionals first, then options as --name, -s or --name=value. A list argument takes
+    /// the argv entries after its name up to the next option; values are not split on a delimiter. Help is laid out
+    /// for 80 columns. Declaration errors (unknown names in constraints, duplicate names, mandated cycles, gaps in
+    /// positions) are compile errors.
+    template <typename Spec>
+    class Static_Schema {
+    public:
+        static constexpr std::uint32_t npos = helper::Perfect_Hash::npos;
+
+    private:
+        static constexpr auto arguments_ = Spec{}();
+        static constexpr std::size_t n = arguments_.size();
+        static constexpr std::size_t words = (n + 63) / 64;
+
+        // ---- name lookup ----
+
+        struct Key {
+            std::string_view name;
+            std::uint32_t id = npos;
+        };
+
+        static constexpr std::size_t count_keys() {
+            std::size_t count = 0;
+            for (const auto& arg : arguments_) {
+                count += arg._short_name.empty() ? 1 : 2;
+                if (!arg._aliases.empty()) helper::split(arg._aliases, '|', [&count](std::string_view) { count++; });
             }
-            if (required_positionals_.empty()) {
-                goto optional_positionals_loop;
+            return count;
+        }
+        static constexpr std::size_t key_count = count_keys();
+
+        static constexpr std::array<Key, key_count> make_keys() {
+            std::array<Key, key_count> keys{};
+            std::size_t k = 0;
+            for (std::uint32_t id = 0; id < n; id++) {
+                const auto& arg = arguments_[id];
+                keys[k++] = {arg._canonical_name, id};
+                if (!arg._short_name.empty()) keys[k++] = {arg._short_name, id};
+                if (!arg._aliases.empty()) helper::split(arg._aliases, '|', [&](const std::string_view alias) { keys[k++] = {alias, id}; });
             }
-
-            // split into 2 parts, one for loop for required, and one for optional
-            for (auto p : required_positionals_) {
-                if (argv_index == argc_) {
-                    display_help("There are less than required number of positionals");
+            for (std::size_t i = 0; i < key_count; i++) {
+                for (std::size_t j = i + 1; j < key_count; j++) {
+                    if (keys[i].name == keys[j].name)
+                        throw exceptions::add_argument_error("a name is used by more than one argument.");
                 }
-
-                results_[p.canonical_name_] = argv_[argv_index++];
             }
+            return keys;
+        }
+        static constexpr auto keys_ = make_keys();
+
+        // hash-and-displace as in helper::Perfect_Hash: a first hash spreads the keys into buckets of about four, each
+        // bucket gets the first seed that sends all of its keys to free slots, placing the largest buckets first
+        static constexpr std::size_t bucket_count_ = key_count / 4 + 1;
+
+        struct Placement {
+            std::vector<std::uint32_t> seeds;
+            std::vector<std::uint32_t> slots; // key index stored in each slot, npos when free
+            bool ok = true;
+        };
+
+        static constexpr Placement place(const std::size_t slot_count) {
+            Placement out{std::vector<std::uint32_t>(bucket_count_, 0), std::vector<std::uint32_t>(slot_count, npos)};
+            std::vector<std::vector<std::uint32_t>> buckets(bucket_count_);
+            for (std::uint32_t k = 0; k < key_count; k++) buckets[helper::hash(keys_[k].name, 0) % bucket_count_].push_back(k);
+            std::vector<std::uint32_t> order(bucket_count_);
+            for (std::uint32_t b = 0; b < bucket_count_; b++) order[b] = b;
+            std::sort(order.begin(), order.end(), [&](const std::uint32_t a, const std::uint32_t b) {
+                return buckets[a].size() != buckets[b].size() ? buckets[a].size() > buckets[b].size() : a < b;
+            });
+
+            std::vector<std::size_t> placed;
+            for (const std::uint32_t b : order) {
+                const auto& bucket = buckets[b];
+                if (bucket.empty()) break;
+                std::uint32_t seed = 1;
+                for (; seed < (1u << 16); seed++) {
+                    placed.clear();
+                    bool fits = true;
+                    for (const std::uint32_t k : bucket) {
+                        const std::size_t slot = helper::hash(keys_[k].name, seed) % slot_count;
+                        if (out.slots[slot] != npos || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                            fits = false;
+                            break;
+                        }
+                        placed.push_back(slot);
+                    }
+                    if (fits) break;
+                }
+                if (seed == (1u << 16)) {
+                    out.ok = false;
+                    return out;
+                }
+                out.seeds[b] = seed;
+                for (std::size_t i = 0; i < bucket.size(); i++) out.slots[placed[i]] = bucket[i];
+            }
+            return out;
+        }
 
-            if (optional_positionals_.empty()) {
-                return;
+        /// a 0.8 load factor like Perfect_Hash, grown until every bucket finds a seed
+        static constexpr std::size_t table_size() {
+            std::size_t size = key_count + key_count / 4 + 1;
+            for (int attempt = 0; attempt < 8; attempt++, size += size / 2 + 1) {
+                if (place(size).ok) return size;
+            }
+            throw exceptions::add_argument_error("no perfect hash for the name table.");
+        }
+        static constexpr std::size_t table_size_ = table_size();
+
+        static constexpr std::array<std::uint32_t, bucket_count_> seeds_ = [] {
+            std::array<std::uint32_t, bucket_count_> seeds{};
+            const Placement placement = place(table_size_);
+            for (std::size_t b = 0; b < bucket_count_; b++) seeds[b] = placement.seeds[b];
+            return seeds;
+        }();
+
+        static constexpr std::array<std::uint32_t, table_size_> table_ = [] {
+            std::array<std::uint32_t, table_size_> table{};
+            const Placement placement = place(table_size_);
+            for (std::size_t i = 0; i < table_size_; i++) table[i] = placement.slots[i];
+            return table;
+        }();
+
+        // ---- positionals ----
+
+        static constexpr std::size_t count_positionals() {
+            std::size_t count = 0;
+            for (const auto& arg : arguments_) count += arg._position > 0;
+            return count;
+        }
+        static constexpr std::size_t positional_count = count_positionals();
+
+        static constexpr std::array<std::uint32_t, positional_count> make_positionals() {
+            std::array<std::uint32_t, positional_count> ids{};
+            for (auto& id : ids) id = npos;
+            for (std::uint32_t id = 0; id < n; id++) {
+                const int position = arguments_[id]._position;
+                if (position == 0) continue;
+                if (static_cast<std::size_t>(position) > positional_count || ids[position - 1] != npos)
+                    throw exceptions::add_argument_error("positions must be 1, 2, ... without gaps or repeats.");
+                ids[position - 1] = id;
             }
+            return ids;
+        }
+        static constexpr auto positionals_ = make_positionals();
+
+        // ---- constraints ----
 
-            optional_positionals_loop:
+        using Bits = std::array<std::uint64_t, words>;
 
-            for (auto p : optional_positionals_) {
+        static constexpr std::uint32_t lookup(const std::string_view name) noexcept {
+            const std::uint32_t seed = seeds_[helper::hash(name, 0) % bucket_count_];
+            const std::uint32_t k = table_[helper::hash(name, seed) % table_size_];
+            return k != npos && keys_[k].name == name ? keys_[k].id : npos;
+        }
 
+        static constexpr std::array<Bits, n> make_sets(std::string_view Static_Argument::* list) {
+            std::array<Bits, n> sets{};
+            for (std::size_t id = 0; id < n; id++) {
+                const std::string_view names = arguments_[id].*list;
+                if (names.empty()) continue;
+                helper::split(names, '|', [&](const std::string_view name) {
+                    const std::uint32_t other = lookup(name);
+                    if (other == npos) throw exceptions::add_argument_error("a constraint names an unknown argument.");
+                    sets[id][other / 64] |= std::uint64_t{1} << (other % 64);
+                });
             }
+            return sets;
+        }
 
+        /// mandated closed transitively; an argument that ends up mandating itself is part of a cycle
+        static constexpr std::array<Bits, n> make_mandated() {
+            auto sets = make_sets(&Static_Argument::_mandated);
+            for (std::size_t k = 0; k < n; k++) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!((sets[i][k / 64] >> (k % 64)) & 1)) continue;
+                    for (std::size_t w = 0; w < words; w++) sets[i][w] |= sets[k][w];
+                }
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                if ((sets[i][i / 64] >> (i % 64)) & 1) throw exceptions::add_argument_error("mandated arguments form a cycle.");
+            }
+            return sets;
         }
 
-        friend struct Argument;
+        static constexpr auto conflicts_ = make_sets(&Static_Argument::_conflicts_with);
+        static constexpr auto mandated_ = make_mandated();
+        static constexpr auto one_of_ = make_sets(&Static_Argument::_requires_one_of);
+
+        // ---- help ----
+
+        /// counts the characters instead of storing them, to size the help buffer
+        struct Counter {
+            std::size_t size = 0;
+            constexpr void push_back(char) { size++; }
+            constexpr void append(const std::string_view s) { size += s.size(); }
+            constexpr void append(const std::size_t count, char) { size += count; }
+        };
+
+        template <std::size_t Size>
+        struct Buffer {
+            std::array<char, Size> data{};
+            std::size_t size = 0;
+            constexpr void push_back(const char c) { data[size++] = c; }
+            constexpr void append(const std::string_view s) { for (const char c : s) data[size++] = c; }
+            constexpr void append(const std::size_t count, const char c) { for (std::size_t i = 0; i < count; i++) data[size++] = c; }
+        };
+
+        template <typename Out>
+        static constexpr void names_of(Out& out, const Static_Argument& arg) {
+            if (arg._short_name.empty()) {
+                out.append("    ");
+            } else {
+                out.push_back('-');
+                out.append(arg._short_name);
+                out.append(", ");
+            }
+            out.append("--");
+            out.append(arg._canonical_name);
+            if (!arg._aliases.empty()) {
+                helper::split(arg._aliases, '|', [&out](const std::string_view alias) {
+                    out.append(", --");
+                    out.append(alias);
+                });
+            }
+            if (arg._takes_value) {
+                out.append(" <");
+                out.append(arg._value_name);
+                out.append(arg._max_values == 1 ? ">" : ">...");
+            }
+        }
 
-    public:
-        Parser(const int argc, char** argv)
-            : argc_(argc), argv_(argv), argv_index(0)
-        {}
+        static constexpr std::size_t names_width(const Static_Argument& arg) {
+            if (arg._position > 0) return arg._value_name.size();
+            Counter counter;
+            names_of(counter, arg);
+            return counter.size;
+        }
 
-        /// Make argument visible to the parser
-        ///
-        /// @param name would be implicitly used as long name for argument unless set explicitly. Otherwise, it acts as a unique indexing identifier to distinguish between arguments.
-        Argument& add_argument(const std::string &name) {
-            const auto arg = std::shared_ptr<Argument>();
-            arg->long_name(name);
+        /// same layout as Parser::help(): the text after "usage: <program>"
+        template <typename Out>
+        static constexpr void render_help(Out& out) {
+            constexpr std::size_t width = 80;
+            constexpr std::size_t indent = 2;
+            constexpr std::size_t gap = 2;
+
+            out.append(" [options]");
+            for (const std::uint32_t id : positionals_) {
+                out.append(" <");
+                out.append(arguments_[id]._value_name);
+                out.push_back('>');
+            }
+            out.push_back('\n');
 
-            arguments_.push_back(arg);
-            argument_map_[name] = arg;
+            std::size_t left = 0;
+            for (const auto& arg : arguments_) {
+                if (!arg._hidden && names_width(arg) <= width / 3) left = std::max(left, names_width(arg));
+            }
+            const std::size_t column = indent + left + gap;
+
+            const auto entry = [&](const Static_Argument& arg) {
+                out.append(indent, ' ');
+                if (arg._position > 0) out.append(arg._value_name);
+                else names_of(out, arg);
+                const std::size_t used = indent + names_width(arg);
+                if (arg._description.empty() && !arg._required) {
+                    out.push_back('\n');
+                    return;
+                }
+                if (used + gap > column) {
+                    out.push_back('\n');
+                    out.append(column, ' ');
+                } else {
+                    out.append(column - used, ' ');
+                }
+                helper::append_wrapped(out, arg._description, column, column, width);
+                if (arg._required && arg._position == 0) helper::append_wrapped(out, arg._description.empty() ? "(required)" : " (required)", column, column, width);
+                out.push_back('\n');
+            };
+
+            if (positional_count > 0) {
+                out.append("\npositional arguments:\n");
+                for (const std::uint32_t id : positionals_) {
+                    if (!arguments_[id]._hidden) entry(arguments_[id]);
+                }
+            }
+            bool first = true;
+            for (const auto& arg : arguments_) {
+                if (arg._hidden || arg._position > 0) continue;
+                if (first) out.append("\noptions:\n");
+                first = false;
+                entry(arg);
+            }
+        }
 
-            arg->parser_ = this;
-            return *arg;
+        static constexpr std::size_t help_size() {
+            Counter counter;
+            render_help(counter);
+            return counter.size;
         }
 
-        void display_help(
-            std::string condition_message = "" // A helpful message to display alongside the help, empty for no message
-        ) {
+        static constexpr auto help_ = [] {
+            Buffer<help_size()> buffer;
+            render_help(buffer);
+            return buffer.data;
+        }();
 
+        // ---- parsing ----
+
+        static bool is_allowed(const Static_Argument& arg, const std::string_view value) noexcept {
+            if (arg._allowed_values.empty()) return true;
+            bool found = false;
+            helper::split(arg._allowed_values, '|', [&](const std::string_view choice) { found = found || choice == value; });
+            return found;
         }
 
-        void parse() {
-            // NOTE before parsing anything, either validate the program name or ignore it
-            argv_index++; // skip
+        static bool set_value(Static_Result<n>& result, const std::uint32_t id, const std::string_view value) {
+            if (!is_allowed(arguments_[id], value)) {
+                return result.fail("invalid value \"" + std::string(value) + "\" for argument \"" + std::string(arguments_[id]._canonical_name) + "\"");
+            }
+            result.values_[id] = value;
+            return true;
+        }
 
-            // NOTE make a solution for positional arguments
-            parse_positional_arguments();
+        static bool check_constraints(Static_Result<n>& result) {
+            const auto name = [](const std::size_t id) { return "\"" + std::string(arguments_[id]._canonical_name) + "\""; };
+            for (std::size_t id = 0; id < n; id++) {
+                if (!result.provided(static_cast<std::uint32_t>(id))) {
+                    if (arguments_[id]._required) return result.fail("missing required argument " + name(id));
+                    continue;
+                }
+                bool any = false;
+                bool needed = false;
+                for (std::size_t w = 0; w < words; w++) {
+                    if (const std::uint64_t hit = conflicts_[id][w] & result.provided_[w]) {
+                        return result.fail("argument " + name(id) + " cannot be used with " + name(w * 64 + std::countr_zero(hit)));
+                    }
+                    if (const std::uint64_t miss = mandated_[id][w] & ~result.provided_[w]) {
+                        return result.fail("argument " + name(id) + " requires " + name(w * 64 + std::countr_zero(miss)));
+                    }
+                    any = any || (one_of_[id][w] & result.provided_[w]);
+                    needed = needed || one_of_[id][w];
+                }
+                if (needed && !any) {
+                    return result.fail("argument " + name(id) + " requires one of " + std::string(arguments_[id]._requires_one_of));
+                }
+            }
+            return true;
+        }
 
-            for (; argv_index < this->argc_; argv_index++) {
-                std::string arg = next();
+    public:
+        /// @brief id of the argument with the given canonical name, short name or alias, npos if unknown.
+        /// @details Usable in constant expressions, e.g. constexpr auto level = schema.id("level").
+        [[nodiscard]] static constexpr std::uint32_t id(const std::string_view name) noexcept {
+            return lookup(name);
+        }
 
-                remove_prefix(arg);
+        [[nodiscard]] static constexpr std::size_t size() noexcept {
+            return n;
+        }
 
-                auto it = argument_map_.find(arg);
+        /// help text laid out at compile time, without the leading "usage: <program>"
+        [[nodiscard]] static constexpr std::string_view help() noexcept {
+            return {help_.data(), help_.size()};
+        }
 
-                // if it does not match any allowed arguments
-                if (it == argument_map_.end()) { display_help(); return; }
+        /// prints usage and help with one write, to stderr after "error: <message>" when a message is given
+        static void display_help(const std::string_view program, const std::string_view condition_message = "") {
+            const bool error = !condition_message.empty();
+            helper::write_out(error, {
+                error ? "error: " : "", condition_message, error ? "\n\n" : "",
+                "usage: ", program, help()
+            });
+        }
 
-                std::shared_ptr<Argument> argument = it->second;
+        /// parses a command line laid out like main's argv; nothing is allocated unless the parse fails
+        static Static_Result<n> parse(const std::span<const char* const> args) {
+            Static_Result<n> result;
+            result.args_ = args;
+            for (std::size_t id = 0; id < n; id++) {
+                if (!arguments_[id]._default_value.empty()) result.values_[id] = arguments_[id]._default_value;
+            }
+            const auto touch = [&result](const std::uint32_t id) { result.provided_[id / 64] |= std::uint64_t{1} << (id % 64); };
 
+            std::size_t i = 1;
+            for (const std::uint32_t id : positionals_) {
+                if (i >= args.size()) {
+                    result.fail("There are less than required number of positionals");
+                    return result;
+                }
+                if (!set_value(result, id, args[i++])) return result;
+                touch(id);
+            }
 
+            while (i < args.size()) {
+                const std::string_view token = args[i++];
+                std::string_view name = token;
+                if (name.starts_with("--")) name.remove_prefix(2);
+                else if (name.starts_with("-")) name.remove_prefix(1);
+                const std::size_t eq = name.find('=');
+                const std::uint32_t id = lookup(name.substr(0, eq));
+                if (id == npos) {
+                    result.fail("unknown argument \"" + std::string(token) + "\"");
+                    return result;
+                }
+                const Static_Argument& arg = arguments_[id];
+                touch(id);
+
+                if (arg._is_flag) {
+                    if (eq != std::string_view::npos) {
+                        result.fail("argument \"" + std::string(name.substr(0, eq)) + "\" does not take a value");
+                        return result;
+                    }
+                    continue;
+                }
+                if (arg._max_values == 1) {
+                    std::string_view value;
+                    if (eq != std::string_view::npos) value = name.substr(eq + 1);
+                    else if (i < args.size() && !(std::string_view(args[i]).size() > 1 && args[i][0] == '-')) value = args[i++];
+                    else {
+                        result.fail("argument \"" + std::string(name) + "\" expects at least 1 value(s)");
+                        return result;
+                    }
+                    if (!set_value(result, id, value)) return result;
+                    continue;
+                }
+                if (eq != std::string_view::npos) {
+                    result.fail("argument \"" + std::string(name.substr(0, eq)) + "\" takes its values as separate arguments");
+                    return result;
+                }
+                const std::size_t begin = i;
+                while (i < args.size() && (arg._max_values == -1 || i - begin < static_cast<std::size_t>(arg._max_values))) {
+                    const std::string_view value = args[i];
+                    if (value.size() > 1 && value.front() == '-') break;
+                    if (!is_allowed(arg, value)) {
+                        set_value(result, id, value);
+                        return result;
+                    }
+                    i++;
+                }
+                if (i - begin < static_cast<std::size_t>(arg._min_values)) {
+                    result.fail("argument \"" + std::string(name) + "\" expects at least " + std::to_string(arg._min_values) + " value(s)");
+                    return result;
+                }
+                result.list_begin_[id] = static_cast<std::uint32_t>(begin);
+                result.list_size_[id] = static_cast<std::uint32_t>(i - begin);
+                result.lists_[id / 64] |= std::uint64_t{1} << (id % 64);
             }
+
+            check_constraints(result);
+            return result;
         }
 
+        static Static_Result<n> parse(const int argc, const char* const* argv) {
+            return parse({argv, static_cast<std::size_t>(argc)});
+        }
     };
 
-    inline Argument& Argument::short_name(const std::string &short_name) {
-        this->_aliases.push_back(short_name);
-        if (parser_) parser_->register_alias(short_name, *this);
-        return *this;
+    /// @brief Declares a schema at compile time.
+    /// @details spec is a captureless lambda returning a std::array of Static_Argument:
+    ///
+    ///     constexpr auto schema = argcpp::make_static_schema([] {
+    ///         return std::array{
+    ///             argcpp::Static_Argument("level").takes_value().allowed_values("fast|slow").short_name("l"),
+    ///             argcpp::Static_Argument("input").position(1).help("file to read"),
+    ///         };
+    ///     });
+    ///     auto result = schema.parse(argc, argv);
+    template <typename Spec>
+        requires std::is_empty_v<Spec> && std::default_initializable<Spec>
+    consteval Static_Schema<Spec> make_static_schema(Spec) {
+        return {};
     }
+}
 
-    inline Argument& Argument::aliases(const std::vector<std::string> &alias_list) {
-        this->_aliases = alias_list;
-        for (auto &alias : alias_list) {
-            if (parser_) parser_->register_alias(alias, *this);
+// Counting replacement of the global allocation functions, for allocation totals in argcpp::profile(). Define
+// ARGCPP_INSTRUMENT_ALLOCATIONS in exactly one translation unit of the program. Allocations are counted on threads
+// whose profile exists; over-aligned blocks keep the pointer malloc returned just before the aligned address.
+#if ARGCPP_INSTRUMENT && defined(ARGCPP_INSTRUMENT_ALLOCATIONS)
+namespace argcpp::helper {
+    inline void count_allocation(const std::size_t size) noexcept {
+        if (Profile* const profile = live_profile) {
+            profile->allocations++;
+            profile->bytes += size;
         }
-        return *this;
     }
 
-    inline Positional& Argument::position(const int position) {
-        if (position < 0) {
-            throw exceptions::add_argument_error("positional arguments must have non-negative positions.");
-        }
-
-        _is_flag = false;
-        _takes_value = false;
-        _required = true;
-        _is_positional = true;
+    inline void* allocate_aligned(const std::size_t size, const std::align_val_t alignment) noexcept {
+        const auto align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+        void* raw = std::malloc(size + align + sizeof(void*));
+        if (!raw) return nullptr;
+        const auto address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        void* aligned = reinterpret_cast<void*>((address + align - 1) & ~(align - 1));
+        static_cast<void**>(aligned)[-1] = raw;
+        return aligned;
+    }
 
-        // add positional argument to vector
-        if (parser_) {
-            Positional p;
-            p.canonical_name_ = this->_canonical_name;
-            helper::push_back_and_replace(parser_->required_positionals_, position, p);
-            this->_position = position;
-            // Return reference to the inserted/updated Positional
-            return parser_->required_positionals_[position];
-        } else {
-            throw exceptions::add_argument_error("No parser associated with this Argument for position().");
-        }
+    inline void free_aligned(void* p) noexcept {
+        if (p) std::free(static_cast<void**>(p)[-1]);
     }
+}
 
-    inline Argument &Argument::optional() {
-        // if there exists a parser object and `this` is positional,
-        // then we remove the last index of required_positionals and
-        // move it to optional_positionals
-        if (parser_ && this->_is_positional) {
-            const Positional p = parser_->required_positionals_[parser_->optional_positionals_.size() - 1];
-            parser_->optional_positionals_.push_back(p);
-            parser_->required_positionals_.pop_back();
-        }
-        this->_required = false;
+void* operator new(const std::size_t size) {
+    argcpp::helper::count_allocation(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
 
+void* operator new[](const std::size_t size) {
+    return ::operator new(size);
+}
 
-        return *this;
-    }
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+    argcpp::helper::count_allocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    argcpp::helper::count_allocation(size);
+    if (void* p = argcpp::helper::allocate_aligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    argcpp::helper::count_allocation(size);
+    return argcpp::helper::allocate_aligned(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, alignment, tag);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    argcpp::helper::free_aligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    argcpp::helper::free_aligned(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    argcpp::helper::free_aligned(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    argcpp::helper::free_aligned(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    argcpp::helper::free_aligned(p);
+}
 
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    argcpp::helper::free_aligned(p);
 }
+#endif
 
 #endif //SINGLE_HPP
@@ -0,0 +1,132 @@
+// Counts global allocations around parse(): a reused parser and a ParseResult on a caller-owned monotonic resource
+// must not touch the heap for a typical command line. Both the plain and the std::align_val_t overloads are counted,
+// Value blocks reach operator new through std::pmr::new_delete_resource(), which uses the aligned ones.
+#include <single.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include "check.hpp"
+
+namespace {
+    std::size_t plain_allocations = 0;
+    std::size_t aligned_allocations = 0;
+
+    std::size_t allocations() {
+        return plain_allocations + aligned_allocations;
+    }
+
+    void* allocate(const std::size_t n) noexcept {
+        plain_allocations++;
+        return std::malloc(n ? n : 1);
+    }
+
+    // malloc a block large enough to align by hand and keep the malloc pointer just below the aligned address
+    void* allocate_aligned(const std::size_t n, const std::align_val_t alignment) noexcept {
+        aligned_allocations++;
+        const auto align = static_cast<std::size_t>(alignment);
+        void* raw = std::malloc(n + align + sizeof(void*));
+        if (!raw) return nullptr;
+        const auto base = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        void* aligned = reinterpret_cast<void*>((base + align - 1) & ~(align - 1));
+        static_cast<void**>(aligned)[-1] = raw;
+        return aligned;
+    }
+
+    // kept out of line: inlined into a delete expression, GCC would pair free() with new and warn
+#if defined(__GNUC__)
+    [[gnu::noinline]]
+#endif
+    void release(void* p) noexcept {
+        std::free(p);
+    }
+
+#if defined(__GNUC__)
+    [[gnu::noinline]]
+#endif
+    void release_aligned(void* p) noexcept {
+        if (p) std::free(static_cast<void**>(p)[-1]);
+    }
+
+    void* or_throw(void* p) {
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+}
+
+void* operator new(const std::size_t n) { return or_throw(allocate(n)); }
+void* operator new[](const std::size_t n) { return or_throw(allocate(n)); }
+void* operator new(const std::size_t n, const std::nothrow_t&) noexcept { return allocate(n); }
+void* operator new[](const std::size_t n, const std::nothrow_t&) noexcept { return allocate(n); }
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+
+void* operator new(const std::size_t n, const std::align_val_t a) { return or_throw(allocate_aligned(n, a)); }
+void* operator new[](const std::size_t n, const std::align_val_t a) { return or_throw(allocate_aligned(n, a)); }
+void* operator new(const std::size_t n, const std::align_val_t a, const std::nothrow_t&) noexcept { return allocate_aligned(n, a); }
+void* operator new[](const std::size_t n, const std::align_val_t a, const std::nothrow_t&) noexcept { return allocate_aligned(n, a); }
+void operator delete(void* p, std::align_val_t) noexcept { release_aligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { release_aligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { release_aligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { release_aligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { release_aligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { release_aligned(p); }
+
+int main() {
+    const char* argv[] = {"prog", "input-file-with-a-long-name.txt", "--output=some/long/path/to/file.txt", "-v",
+                          "--level", "3", "--ids", "1,2,3,4,5,6", "--very-long-flag-name-here",
+                          "--path", "given"};
+    argcpp::Parser parser;
+    parser.add_argument("input").position(1);
+    parser.add_argument("output").takes_value();
+    parser.add_argument("verbose").short_name("v");
+    parser.add_argument("level").takes_value().default_value(1);
+    parser.add_argument("ids").takes_value().x_value_range(1, -1);
+    parser.add_argument("very-long-flag-name-here");
+    parser.add_argument("unused").takes_value().default_value(std::string("dflt"));
+    parser.add_argument("path").takes_value().default_value(std::string("a/default/longer/than/sixteen"));
+
+    // the counters see aligned allocations at all
+    const std::size_t aligned_before = aligned_allocations;
+    parser.parse(argv);
+    CHECK(parser.ok());
+    CHECK(aligned_allocations > aligned_before);
+
+    // reused parse: the second and later parses reuse the storage of the first, the touched long default included
+    std::size_t before_plain = plain_allocations;
+    std::size_t before_aligned = aligned_allocations;
+    for (int i = 0; i < 100; i++) parser.parse(argv);
+    CHECK(plain_allocations == before_plain);
+    CHECK(aligned_allocations == before_aligned);
+    CHECK(parser.ok());
+    CHECK(parser.get("output").view() == "some/long/path/to/file.txt");
+    CHECK(parser.get("input").view() == "input-file-with-a-long-name.txt");
+    CHECK(parser.get("level").view() == "3");
+    CHECK(parser.get("ids").list().size() == 6);
+    CHECK(parser.get("unused").view() == "dflt");
+    CHECK(parser.get("path").view() == "given");
+    CHECK(parser.provided("verbose"));
+    CHECK(!parser.provided("unused"));
+
+    // fresh results on a monotonic resource over a fixed buffer, which throws rather than reach the heap
+    const argcpp::Schema& schema = parser.schema();
+    alignas(std::max_align_t) static char buffer[1 << 16];
+    for (int round = 0; round < 3; round++) {
+        std::pmr::monotonic_buffer_resource resource(buffer, sizeof buffer, std::pmr::null_memory_resource());
+        const std::size_t before = allocations();
+        {
+            argcpp::ParseResult result(&resource);
+            schema.parse(argv, result);
+            CHECK(result.ok());
+            CHECK(result.get("ids").list().size() == 6);
+            CHECK(result.get("output").view() == "some/long/path/to/file.txt");
+            CHECK(result.get("path").view() == "given");
+        }
+        CHECK(allocations() == before);
+    }
+    return argc_test::result();
+}
@@ -0,0 +1,88 @@
+// parse_batch(): results in input order with per-result errors, for any thread count, allocating from the resource
+// it is given.
+#include <single.hpp>
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+namespace {
+    /// forwards to a synchronized pool and counts what passes through
+    class Counting_Resource : public std::pmr::memory_resource {
+        std::pmr::synchronized_pool_resource upstream_;
+
+        void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+            allocations++;
+            return upstream_.allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override {
+            deallocations++;
+            upstream_.deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        std::atomic<std::size_t> allocations{0};
+        std::atomic<std::size_t> deallocations{0};
+    };
+}
+
+int main() {
+    argcpp::Parser parser;
+    parser.add_argument("input").position(1);
+    parser.add_argument("level").takes_value().default_value(1);
+    parser.add_argument("ids").takes_value().x_value_range(1, -1);
+    parser.add_argument("mode").takes_value().allowed_values({"fast", "slow"});
+
+    constexpr std::size_t n = 1000;
+    std::vector<std::string> inputs;
+    std::vector<std::string> levels;
+    for (std::size_t i = 0; i < n; i++) {
+        inputs.push_back("in-" + std::to_string(i));
+        levels.push_back(std::to_string(i));
+    }
+    std::vector<std::vector<const char*>> commands;
+    for (std::size_t i = 0; i < n; i++) {
+        if (i % 10 == 9) commands.push_back({"prog", inputs[i].c_str(), "--mode", "bogus"});
+        else commands.push_back({"prog", inputs[i].c_str(), "--level", levels[i].c_str(), "--ids", "1,2,3,4"});
+    }
+
+    const auto matches = [&](const std::vector<argcpp::ParseResult>& results) {
+        if (results.size() != n) return false;
+        for (std::size_t i = 0; i < n; i++) {
+            const argcpp::ParseResult& r = results[i];
+            if (i % 10 == 9) {
+                if (r.ok() || r.error().find("bogus") == std::string::npos) return false;
+            } else if (!r.ok() || r.get("input").view() != inputs[i] || r.get("level").get<std::size_t>().value != i ||
+                       r.get("ids").list().size() != 4) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const argcpp::Schema& schema = parser.schema();
+    for (const unsigned threads : {0u, 1u, 4u}) {
+        CHECK(matches(schema.parse_batch(commands, threads)));
+    }
+    CHECK(matches(parser.parse_batch(commands, 3)));
+    CHECK(schema.parse_batch(std::vector<std::vector<const char*>>{}).empty());
+
+    // the results and the lists inside their values come from the resource passed in
+    Counting_Resource resource;
+    {
+        const std::vector<argcpp::ParseResult> results = parser.parse_batch(commands, 4, &resource);
+        CHECK(matches(results));
+        bool all_from_resource = true;
+        for (const argcpp::ParseResult& r : results) all_from_resource = all_from_resource && r.resource() == &resource;
+        CHECK(all_from_resource);
+        CHECK(resource.allocations >= n);
+    }
+    CHECK(resource.allocations == resource.deallocations);
+    return argc_test::result();
+}
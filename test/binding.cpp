@@ -0,0 +1,62 @@
+// bind() stores converted values into variables and leaves them alone when a value does not convert.
+#include <single.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+namespace {
+    enum class Mode { fast, slow, safe };
+}
+
+int main() {
+    {
+        const char* argv[] = {"prog", "in.txt", "a", "b", "-j", "8", "--mode", "SAFE", "-v", "--ratio", "0.5",
+                              "--tags", "x,y,z", "--level", "0x10"};
+        int jobs = 1;
+        Mode mode = Mode::fast;
+        bool verbose = false;
+        double ratio = 0;
+        std::vector<std::string> tags;
+        std::optional<long> level;
+        std::string input;
+        std::vector<std::string_view> rest;
+        std::string name = "keep";
+        std::optional<int> none;
+
+        argcpp::Parser parser;
+        parser.add_argument("input").position(1).bind(input);
+        parser.add_argument("rest").position(2).variadic().bind(rest);
+        parser.add_argument("jobs").short_name("j").takes_value().bind(jobs);
+        parser.add_argument("mode").takes_value().allowed_values({"fast", "slow", "safe"}).case_sensitive(false).bind(mode);
+        parser.add_argument("verbose").short_name("v").bind(verbose);
+        parser.add_argument("ratio").takes_value().bind(ratio);
+        parser.add_argument("tags").takes_value().x_value_range(1, -1).bind(tags);
+        parser.add_argument("level").takes_value().bind(level);
+        parser.add_argument("name").takes_value().bind(name);
+        parser.add_argument("none").takes_value().bind(none);
+        parser.parse(argv);
+        CHECK(parser.ok());
+        CHECK(input == "in.txt");
+        CHECK(rest.size() == 2 && rest[1] == "b");
+        CHECK(jobs == 8);
+        CHECK(mode == Mode::safe);
+        CHECK(verbose);
+        CHECK(ratio == 0.5);
+        CHECK(tags == std::vector<std::string>({"x", "y", "z"}));
+        CHECK(level && *level == 16);
+        CHECK(name == "keep");
+        CHECK(!none);
+    }
+    {
+        // a value that does not convert fails the parse and leaves the variable alone
+        int jobs = 3;
+        argcpp::Parser parser;
+        parser.add_argument("jobs").short_name("j").takes_value().bind(jobs);
+        const char* argv[] = {"prog", "-j", "many"};
+        parser.parse(argv);
+        CHECK(!parser.ok());
+        CHECK(jobs == 3);
+    }
+    return argc_test::result();
+}
@@ -0,0 +1,25 @@
+#ifndef ARGCPP_TEST_CHECK_HPP
+#define ARGCPP_TEST_CHECK_HPP
+
+#include <cstdio>
+
+/// minimal assertion helper shared by the test executables, a failed CHECK reports and the test exits non-zero
+namespace argc_test {
+    inline int failures = 0;
+
+    inline void check(const bool ok, const char* expression, const char* file, const int line) {
+        if (!ok) {
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+            failures++;
+        }
+    }
+
+    inline int result() {
+        if (failures) std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return failures ? 1 : 0;
+    }
+}
+
+#define CHECK(condition) argc_test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+#endif // ARGCPP_TEST_CHECK_HPP
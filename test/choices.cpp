@@ -0,0 +1,70 @@
+// allowed_values() compiled into hashed choice sets: index lookup, case folding, duplicates, and the parse errors.
+#include <single.hpp>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+int main() {
+    using argcpp::helper::Choice_Set;
+    constexpr std::uint32_t npos = argcpp::helper::Perfect_Hash::npos;
+
+    const Choice_Set exact({"fast", "slow", "Safe"}, true);
+    CHECK(exact.find("fast") == 0);
+    CHECK(exact.find("slow") == 1);
+    CHECK(exact.find("Safe") == 2);
+    CHECK(exact.find("safe") == npos);
+    CHECK(exact.find("FAST") == npos);
+    CHECK(exact.find("fastest") == npos);
+    CHECK(exact.find("") == npos);
+
+    const Choice_Set folded({"fast", "slow", "Safe"}, false);
+    CHECK(folded.find("FAST") == 0);
+    CHECK(folded.find("sLoW") == 1);
+    CHECK(folded.find("safe") == 2);
+    CHECK(folded.find("SAFE") == 2);
+    CHECK(folded.find("fas") == npos);
+    // the declared spelling is kept for messages
+    CHECK(folded.choices() == std::vector<std::string>({"fast", "slow", "Safe"}));
+
+    // a choice listed twice, or twice up to case, keeps its first index
+    const Choice_Set duplicates({"a", "b", "A", "b"}, false);
+    CHECK(duplicates.find("a") == 0);
+    CHECK(duplicates.find("A") == 0);
+    CHECK(duplicates.find("B") == 1);
+
+    // values longer than the fold buffer still fold
+    const std::string long_choice(300, 'x');
+    const Choice_Set wide({long_choice, "y"}, false);
+    CHECK(wide.find(std::string(300, 'X')) == 0);
+    CHECK(wide.find(std::string(301, 'X')) == npos);
+
+    std::vector<std::string> many;
+    for (int i = 0; i < 1000; i++) many.push_back("choice-" + std::to_string(i));
+    const Choice_Set large(many, true);
+    bool all = true;
+    for (std::uint32_t i = 0; i < many.size(); i++) all = all && large.find(many[i]) == i;
+    CHECK(all);
+
+    argcpp::Parser parser;
+    parser.add_argument("mode").takes_value().allowed_values({"fast", "slow", "safe"}).case_sensitive(false);
+    parser.add_argument("level").takes_value().allowed_values({"debug", "info"});
+    parser.add_argument("tags").takes_value().x_value_range(1, -1).allowed_values({"a", "b", "c"});
+    parser.add_argument("free").takes_value();
+    const argcpp::Schema& schema = parser.schema();
+
+    const char* good[] = {"prog", "--mode", "SLOW", "--level", "info", "--tags", "a,c,a"};
+    argcpp::ParseResult result = schema.parse(good);
+    CHECK(result.ok());
+    CHECK(result.choice("mode") == 1);
+    CHECK(result.choice("level") == 1);
+    CHECK(result.choice("free") == npos);
+    const std::uint32_t tags = schema.id("tags");
+    const auto list = result.get("tags").list();
+    CHECK(list.size() == 3 && schema.choice(tags, list[1].view()) == 2);
+
+    const char* wrong_case[] = {"prog", "--level", "INFO"};
+    CHECK(schema.parse(wrong_case).error() == "invalid value \"INFO\" for argument \"level\", expected one of debug, info");
+    const char* wrong_piece[] = {"prog", "--tags", "a,d"};
+    CHECK(!schema.parse(wrong_piece).ok());
+    return argc_test::result();
+}
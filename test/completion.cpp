@@ -0,0 +1,73 @@
+// Shell completion: candidates from the compiled schema, the --__complete entry point and the generated scripts.
+#include <single.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+int main() {
+    const char* program[] = {"/usr/bin/my-tool"};
+    argcpp::Parser parser(1, const_cast<char**>(program));
+    parser.add_argument("mode").position(1).allowed_values({"fast", "slow", "safe"});
+    parser.add_argument("verbose").short_name("v").aliases({"loud"});
+    parser.add_argument("level").takes_value().allowed_values({"debug", "info"});
+    parser.add_argument("secret").hidden();
+    parser.add_argument("out").takes_value();
+    parser.add_subcommand("remote", [](argcpp::Parser& remote) {
+        remote.add_argument("force").short_name("f");
+        remote.add_subcommand("add", [](argcpp::Parser&) {});
+    });
+    parser.add_subcommand("reset", [](argcpp::Parser&) {});
+    // completion never reads config files, so a missing required one does not get in the way
+    parser.config_file("/nonexistent/my-tool.ini", "", true);
+
+    const auto complete = [&parser](const std::vector<const char*>& words, const std::size_t cword) {
+        return parser.complete(words, cword);
+    };
+
+    // positional values, option names and aliases, option values in both spellings
+    CHECK(complete({"my-tool", "s"}, 1) == "slow\nsafe\n");
+    CHECK(complete({"my-tool", "fast", "--l"}, 2) == "--loud\n--level\n");
+    CHECK(complete({"my-tool", "fast", "--level", ""}, 3) == "debug\ninfo\n");
+    CHECK(complete({"my-tool", "fast", "--level", "i"}, 3) == "info\n");
+    CHECK(complete({"my-tool", "fast", "--level=d"}, 2) == "--level=debug\n");
+    CHECK(complete({"my-tool", "fast", "--level", "=", "d"}, 4) == "debug\n");
+    // a value without allowed values falls back to the shell's file names
+    CHECK(complete({"my-tool", "fast", "--out", ""}, 3).empty());
+    // a new word: subcommands and every visible option, hidden ones left out
+    CHECK(complete({"my-tool", "fast"}, 2) == "remote\nreset\n--verbose\n--loud\n-v\n--level\n--out\n");
+    CHECK(complete({"my-tool", "fast", "re"}, 2) == "remote\nreset\n");
+    // after a subcommand word its own parser answers
+    CHECK(complete({"my-tool", "fast", "remote", "--"}, 3) == "--force\n");
+    CHECK(complete({"my-tool", "fast", "remote", "a"}, 3) == "add\n");
+
+    // the entry point answers completion requests and nothing else
+    std::ostringstream answer;
+    const char* request[] = {"my-tool", "--__complete", "2", "my-tool", "fast", "--le"};
+    CHECK(parser.handle_completion(6, request, answer));
+    CHECK(answer.str() == "--level\n");
+
+    std::ostringstream untouched;
+    const char* malformed[] = {"my-tool", "--__complete", "2x", "my-tool", "fast"};
+    CHECK(!parser.handle_completion(5, malformed, untouched));
+    const char* negative[] = {"my-tool", "--__complete", "-1", "my-tool"};
+    CHECK(!parser.handle_completion(4, negative, untouched));
+    const char* ordinary[] = {"my-tool", "fast", "--verbose"};
+    CHECK(!parser.handle_completion(3, ordinary, untouched));
+    const char* short_request[] = {"my-tool", "--__complete"};
+    CHECK(!parser.handle_completion(2, short_request, untouched));
+    CHECK(untouched.str().empty());
+
+    // the scripts call the program back with --__complete under a function named after it
+    const std::string bash = parser.completion_script(argcpp::Shell::bash);
+    CHECK(bash.find("_my_tool_complete() {") != std::string::npos);
+    CHECK(bash.find("--__complete \"$COMP_CWORD\"") != std::string::npos);
+    CHECK(bash.find("complete -o default -F _my_tool_complete my-tool\n") != std::string::npos);
+    const std::string zsh = parser.completion_script(argcpp::Shell::zsh);
+    CHECK(zsh.find("--__complete $((CURRENT - 1))") != std::string::npos);
+    CHECK(zsh.find("compdef _my_tool_complete my-tool\n") != std::string::npos);
+    const std::string fish = parser.completion_script(argcpp::Shell::fish);
+    CHECK(fish.find("function _my_tool_complete\n") != std::string::npos);
+    CHECK(fish.find("complete -c my-tool -a '(_my_tool_complete)'\n") != std::string::npos);
+    return argc_test::result();
+}
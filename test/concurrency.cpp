@@ -0,0 +1,74 @@
+// One compiled Schema shared by many threads, each filling its own ParseResult, and the work-stealing parallel_for
+// underneath parse_batch().
+#include <single.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+
+int main() {
+    argcpp::Parser parser;
+    parser.add_argument("input").position(1);
+    parser.add_argument("level").takes_value().default_value(1);
+    parser.add_argument("ids").takes_value().x_value_range(1, -1);
+    parser.add_argument("mode").takes_value().allowed_values({"fast", "slow"});
+    const argcpp::Schema& schema = parser.schema();
+
+    constexpr int threads = 8;
+    constexpr int rounds = 500;
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&schema, &mismatches, t] {
+            const std::string input = "input-" + std::to_string(t);
+            const std::string level = std::to_string(t * 10);
+            const char* good[] = {"prog", input.c_str(), "--level", level.c_str(), "--ids", "1,2,3", "--mode", "slow"};
+            const char* bad[] = {"prog", input.c_str(), "--mode", "other"};
+            argcpp::ParseResult result;
+            for (int r = 0; r < rounds; r++) {
+                schema.parse(good, result);
+                if (!result.ok() || result.get("input").view() != input || result.get("level").get<int>().value != t * 10 ||
+                    result.get("ids").list().size() != 3 || result.choice("mode") != 1) {
+                    mismatches++;
+                }
+                schema.parse(bad, result);
+                if (result.ok() || result.get("level").get<int>().value != 1) mismatches++;
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    CHECK(mismatches == 0);
+
+    // every index runs exactly once, on a worker in range, whatever the thread count
+    for (const unsigned count : {0u, 1u, 3u, 16u}) {
+        constexpr std::size_t n = 10007;
+        std::vector<std::atomic<int>> seen(n);
+        std::atomic<bool> worker_in_range{true};
+        const unsigned limit = count == 0 ? std::max(1u, std::thread::hardware_concurrency()) : count;
+        argcpp::helper::parallel_for(n, count, [&](const std::size_t i, const unsigned worker) {
+            seen[i]++;
+            if (worker >= limit) worker_in_range = false;
+        });
+        bool once = true;
+        for (const auto& s : seen) once = once && s == 1;
+        CHECK(once);
+        CHECK(worker_in_range);
+    }
+
+    // nothing to do is fine, and an exception from the body reaches the caller
+    bool ran = false;
+    argcpp::helper::parallel_for(0, 4, [&](std::size_t, unsigned) { ran = true; });
+    CHECK(!ran);
+    bool thrown = false;
+    try {
+        argcpp::helper::parallel_for(1000, 4, [](const std::size_t i, unsigned) {
+            if (i == 517) throw std::runtime_error("body failed");
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    return argc_test::result();
+}
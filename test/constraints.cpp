@@ -0,0 +1,57 @@
+// conflicts_with, requires_one_of and mandated at parse time, and the schema errors they raise at compile time.
+#include <single.hpp>
+#include <vector>
+#include "check.hpp"
+
+namespace {
+    bool accepts(const argcpp::Schema& schema, std::vector<const char*> argv) {
+        argv.insert(argv.begin(), "prog");
+        return schema.parse(argv).ok();
+    }
+}
+
+int main() {
+    argcpp::Parser parser;
+    parser.add_argument("tcp").conflicts_with({"udp"}).requires_one_of({"port", "socket"});
+    parser.add_argument("udp");
+    parser.add_argument("port").takes_value();
+    parser.add_argument("socket").takes_value();
+    parser.add_argument("tls").mandated({"cert"});
+    parser.add_argument("cert").takes_value().mandated({"key"});
+    parser.add_argument("key").takes_value();
+    const argcpp::Schema& schema = parser.schema();
+
+    CHECK(accepts(schema, {}));
+    CHECK(!accepts(schema, {"--tcp", "--udp", "--port", "1"}));
+    CHECK(!accepts(schema, {"--tcp"}));
+    CHECK(accepts(schema, {"--tcp", "--port", "1"}));
+    CHECK(accepts(schema, {"--tcp", "--socket", "s"}));
+    CHECK(accepts(schema, {"--udp"}));
+    CHECK(!accepts(schema, {"--tls", "--cert", "c"}));
+    CHECK(!accepts(schema, {"--tls"}));
+    CHECK(accepts(schema, {"--tls", "--cert", "c", "--key", "k"}));
+    CHECK(!accepts(schema, {"--cert", "c"}));
+
+    bool thrown = false;
+    try {
+        argcpp::Parser cycle;
+        cycle.add_argument("a").mandated({"b"});
+        cycle.add_argument("b").mandated({"c"});
+        cycle.add_argument("c").mandated({"a"});
+        cycle.compile();
+    } catch (const argcpp::exceptions::add_argument_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    thrown = false;
+    try {
+        argcpp::Parser unknown;
+        unknown.add_argument("a").conflicts_with({"zz"});
+        unknown.compile();
+    } catch (const argcpp::exceptions::add_argument_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    return argc_test::result();
+}
@@ -0,0 +1,94 @@
+// Value::get<T>(): from_chars parsing with one optional sign and a 0x prefix, range errors per target type, and the
+// per-family cache.
+#include <single.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "check.hpp"
+
+namespace {
+    template <typename T>
+    std::errc error_of(const char* text) {
+        return argcpp::Value(std::string_view(text)).get<T>().error;
+    }
+
+    template <typename T>
+    bool reads(const char* text, const T expected) {
+        const argcpp::Conversion<T> result = argcpp::Value(std::string_view(text)).get<T>();
+        return result && result.value == expected;
+    }
+}
+
+int main() {
+    constexpr std::errc invalid = std::errc::invalid_argument;
+    constexpr std::errc out_of_range = std::errc::result_out_of_range;
+
+    CHECK(reads<int>("42", 42));
+    CHECK(reads<int>("+42", 42));
+    CHECK(reads<int>("-42", -42));
+    CHECK(reads<int>("0x1f", 31));
+    CHECK(reads<int>("+0X1F", 31));
+    CHECK(reads<unsigned>("+7", 7u));
+    CHECK(reads<unsigned>("-0", 0u));
+    CHECK(reads<double>("2.5", 2.5));
+    CHECK(reads<double>("+1e3", 1000.0));
+    CHECK(reads<float>("-0.25", -0.25f));
+    CHECK(reads<bool>("yes", true));
+    CHECK(reads<bool>("OFF", false));
+    CHECK(reads<bool>("1", true));
+
+    // one sign at most, and none after the radix prefix
+    CHECK(error_of<int>("+-5") == invalid);
+    CHECK(error_of<int>("++5") == invalid);
+    CHECK(error_of<int>("0x-5") == invalid);
+    CHECK(error_of<int>("0x+5") == invalid);
+    CHECK(error_of<int>("+0x-5") == invalid);
+    CHECK(error_of<unsigned>("+-5") == invalid);
+    CHECK(error_of<unsigned>("0x-5") == invalid);
+    CHECK(error_of<double>("+-5") == invalid);
+    CHECK(error_of<double>("++5") == invalid);
+    CHECK(error_of<int>("") == invalid);
+    CHECK(error_of<int>("+") == invalid);
+    CHECK(error_of<int>("12abc") == invalid);
+    CHECK(error_of<int>("1.5") == invalid);
+    CHECK(error_of<bool>("maybe") == invalid);
+
+    // range errors: from the text itself, or from narrowing the cached 64-bit result
+    CHECK(error_of<unsigned>("-5") == out_of_range);
+    CHECK(error_of<std::uint64_t>("-1") == out_of_range);
+    CHECK(error_of<unsigned>("-x") == invalid);
+    CHECK(error_of<std::int8_t>("128") == out_of_range);
+    CHECK(error_of<std::int8_t>("-129") == out_of_range);
+    CHECK(reads<std::int8_t>("-128", std::int8_t{-128}));
+    CHECK(error_of<std::uint8_t>("256") == out_of_range);
+    CHECK(error_of<std::int64_t>("99999999999999999999") == out_of_range);
+    CHECK(error_of<float>("1e300") == out_of_range);
+    CHECK(reads<double>("1e300", 1e300));
+
+    // non-text alternatives
+    CHECK(argcpp::Value(5).get<double>().value == 5.0);
+    CHECK(argcpp::Value(-5).get<unsigned>().error == out_of_range);
+    CHECK(argcpp::Value(true).get<bool>().value);
+    CHECK(argcpp::Value(0.5).get<int>().error == invalid);
+    CHECK(argcpp::Value(std::string_view("nope")).get_or<int>(9) == 9);
+
+    // the parse is cached per family: changing the viewed text only shows up in a family not read yet
+    std::string text = "12";
+    const argcpp::Value cached{std::string_view(text)};
+    CHECK(cached.get<int>().value == 12);
+    text = "34";
+    CHECK(cached.get<long>().value == 12);
+    CHECK(cached.get<std::int16_t>().value == 12);
+    CHECK(cached.get<double>().value == 34.0);
+    const argcpp::Value copy = cached;
+    text = "56";
+    CHECK(copy.get<double>().value == 34.0);
+
+    // a cached error is reported again without parsing
+    std::string bad = "x";
+    const argcpp::Value failing{std::string_view(bad)};
+    CHECK(failing.get<int>().error == invalid);
+    bad = "1";
+    CHECK(failing.get<int>().error == invalid);
+    return argc_test::result();
+}
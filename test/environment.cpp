@@ -0,0 +1,63 @@
+// Environment fallbacks: one snapshot of environ taken on the first parse, and explicit env_var() names over
+// env_prefix() matches.
+#include <single.hpp>
+#include <cstdlib>
+#include <string>
+#include "check.hpp"
+
+namespace {
+    void set_env(const char* name, const char* value) {
+#if defined(_WIN32)
+        _putenv_s(name, value);
+#else
+        setenv(name, value, 1);
+#endif
+    }
+}
+
+int main() {
+    using argcpp::Source;
+
+    {
+        argcpp::Parser parser;
+        parser.env_prefix("ARGC_ENV_");
+        parser.add_argument("token").takes_value().env_var("ARGC_ENV_SECRET").required();
+        parser.add_argument("log-level").takes_value();
+        parser.add_argument("verbose").env_var("ARGC_ENV_VERBOSE");
+        parser.add_argument("quiet").env_var("ARGC_ENV_QUIET");
+        parser.add_argument("input").position(1).env_var("ARGC_ENV_INPUT");
+        parser.add_argument("name").takes_value().env_var("ARGC_ENV_NAME").default_value(std::string("default"));
+        parser.compile();
+
+        // set after compile(): the snapshot is taken on the first parse
+        set_env("ARGC_ENV_SECRET", "s3cret");
+        set_env("ARGC_ENV_TOKEN", "by-prefix"); // the explicit ARGC_ENV_SECRET wins for "token"
+        set_env("ARGC_ENV_LOG_LEVEL", "debug");
+        set_env("ARGC_ENV_VERBOSE", "yes");
+        set_env("ARGC_ENV_QUIET", "0");
+        set_env("ARGC_ENV_INPUT", "from-env.txt");
+
+        const char* bare[] = {"prog"};
+        parser.parse(bare);
+        CHECK(parser.ok());
+        CHECK(parser.get("token").view() == "s3cret");
+        CHECK(parser.result().source("token") == Source::environment);
+        CHECK(parser.get("log-level").view() == "debug");
+        CHECK(parser.provided("verbose"));
+        CHECK(!parser.provided("quiet"));
+        CHECK(parser.get("input").view() == "from-env.txt");
+        CHECK(parser.get("name").view() == "default");
+        CHECK(parser.result().source("name") == Source::default_value);
+
+        // the command line wins, and later changes to the environment are not seen
+        set_env("ARGC_ENV_NAME", "too-late");
+        const char* given[] = {"prog", "cli.txt", "--token", "cli"};
+        parser.parse(given);
+        CHECK(parser.ok());
+        CHECK(parser.get("token").view() == "cli");
+        CHECK(parser.result().source("token") == Source::command_line);
+        CHECK(parser.get("input").view() == "cli.txt");
+        CHECK(parser.get("name").view() == "default");
+    }
+    return argc_test::result();
+}
@@ -0,0 +1,55 @@
+// fields() declares arguments from a struct's members and parse_into() fills the struct.
+#include <single.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+namespace {
+    enum class Mode { fast, slow, safe };
+
+    struct Options {
+        int jobs = 1;
+        bool verbose = false;
+        std::vector<std::string> include;
+        Mode mode = Mode::fast;
+        std::optional<double> ratio;
+        std::string name = "n";
+        std::vector<int> ports;
+    };
+
+    constexpr auto options = argcpp::fields(
+        argcpp::Field("jobs", &Options::jobs).short_name("j").default_value("4"),
+        argcpp::Field("verbose", &Options::verbose).short_name("v"),
+        argcpp::Field("include", &Options::include).short_name("I"),
+        argcpp::Field("mode", &Options::mode),
+        argcpp::Field("ratio", &Options::ratio),
+        argcpp::Field("name", &Options::name),
+        argcpp::Field("ports", &Options::ports).default_value("80,443"));
+}
+
+int main() {
+    {
+        const char* argv[] = {"prog", "-v", "-I", "a,b", "--mode", "1", "--ratio", "2.5"};
+        argcpp::Parser parser(8, const_cast<char**>(argv));
+        parser.fields(options);
+        Options object;
+        CHECK(parser.parse_into(object));
+        CHECK(object.jobs == 4);
+        CHECK(object.verbose);
+        CHECK(object.include == std::vector<std::string>({"a", "b"}));
+        CHECK(object.mode == Mode::slow);
+        CHECK(object.ratio && *object.ratio == 2.5);
+        CHECK(object.name == "n");
+        CHECK(object.ports == std::vector<int>({80, 443}));
+    }
+    {
+        const char* argv[] = {"prog", "-j", "x"};
+        argcpp::Parser parser(3, const_cast<char**>(argv));
+        parser.fields(options);
+        Options object;
+        CHECK(!parser.parse_into(object));
+        CHECK(object.jobs == 1);
+    }
+    return argc_test::result();
+}
@@ -0,0 +1,69 @@
+// Help rendering: the layout at a fixed width, wrapping, hidden arguments, categories, and one cached text per width.
+#include <single.hpp>
+#include <string>
+#include <string_view>
+#include "check.hpp"
+
+namespace {
+    std::size_t longest_line(const std::string_view text) {
+        std::size_t longest = 0;
+        std::size_t start = 0;
+        for (std::size_t end = text.find('\n'); end != std::string_view::npos; end = text.find('\n', start)) {
+            longest = std::max(longest, end - start);
+            start = end + 1;
+        }
+        return longest;
+    }
+}
+
+int main() {
+    argcpp::Parser parser;
+    parser.add_argument("input").position(1).help("file to read");
+    parser.add_argument("verbose").short_name("v")
+        .help("print more about what is going on while the tool runs, which can be a lot of output");
+    parser.add_argument("output").short_name("o").takes_value().value_name("FILE").help("where to write");
+    parser.add_argument("secret").hidden().help("never shown");
+    parser.add_argument("port").takes_value().category("network").help("port to listen on");
+
+    const std::string_view narrow = parser.help(40);
+    CHECK(narrow ==
+        " [options] <input>\n"
+        "\n"
+        "positional arguments:\n"
+        "  input          file to read\n"
+        "\n"
+        "options:\n"
+        "  -v, --verbose  print more about what\n"
+        "                 is going on while the\n"
+        "                 tool runs, which can be\n"
+        "                 a lot of output\n"
+        "  -o, --output <FILE>\n"
+        "                 where to write\n"
+        "\n"
+        "network:\n"
+        "      --port <port>\n"
+        "                 port to listen on\n");
+    CHECK(longest_line(narrow) <= 40);
+    CHECK(narrow.find("secret") == std::string_view::npos);
+
+    // a wider terminal widens the name column and stops wrapping
+    const std::string_view wide = parser.help(120);
+    CHECK(wide.find("  -o, --output <FILE>  where to write\n") != std::string_view::npos);
+    CHECK(wide.find("  -v, --verbose        print more about what is going on while the tool runs, which can be a lot of output\n")
+          != std::string_view::npos);
+    CHECK(longest_line(wide) <= 120);
+
+    // each width is rendered once and the text stays put
+    CHECK(parser.help(40).data() == narrow.data());
+    CHECK(parser.help(120).data() == wide.data());
+    CHECK(parser.help(40) == narrow);
+
+    // subcommands get their own section and a usage suffix
+    argcpp::Parser tool;
+    tool.add_subcommand("build", [](argcpp::Parser&) {}, "compile everything");
+    const std::string_view with_commands = tool.help(80);
+    CHECK(with_commands.starts_with(" [options] <command> [<args>...]\n"));
+    CHECK(with_commands.find("build") != std::string_view::npos);
+    CHECK(with_commands.find("compile everything") != std::string_view::npos);
+    return argc_test::result();
+}
@@ -0,0 +1,61 @@
+// Argument storage and name lookup: references into the argument pool stay valid while it grows, and the perfect
+// hash over the compiled names finds every key it was built from and rejects everything else.
+#include <single.hpp>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+int main() {
+    using argcpp::helper::Perfect_Hash;
+
+    std::vector<std::string> names;
+    for (int i = 0; i < 500; i++) names.push_back("option-" + std::to_string(i));
+    for (const char* name : {"a", "b", "v", "verbose", "version", "help", "h", ""}) names.emplace_back(name);
+
+    std::vector<std::pair<std::string_view, std::uint32_t>> entries;
+    for (std::uint32_t i = 0; i < names.size(); i++) entries.emplace_back(names[i], i);
+    const Perfect_Hash hash(entries);
+
+    for (std::uint32_t i = 0; i < names.size(); i++) CHECK(hash.find(names[i]) == i);
+    for (const char* miss : {"option-500", "option-", "verbos", "versions", "c", "H", "option-1 ", "-v"}) {
+        CHECK(hash.find(miss) == Perfect_Hash::npos);
+    }
+
+    const Perfect_Hash empty(std::vector<std::pair<std::string_view, std::uint32_t>>{});
+    CHECK(empty.find("anything") == Perfect_Hash::npos);
+    CHECK(empty.find("") == Perfect_Hash::npos);
+
+    // elements never move while the pool grows
+    argcpp::helper::Stable_Pool<std::string> pool;
+    std::vector<const std::string*> addresses;
+    for (int i = 0; i < 5000; i++) addresses.push_back(&pool.emplace_back(std::to_string(i)));
+    CHECK(pool.size() == 5000);
+    bool stable = true;
+    for (int i = 0; i < 5000; i++) stable = stable && addresses[i] == &pool[i] && *addresses[i] == std::to_string(i);
+    CHECK(stable);
+
+    // an Argument reference returned by add_argument() can be configured after many more arguments were added
+    argcpp::Parser many;
+    argcpp::Argument& first = many.add_argument("first");
+    for (int i = 0; i < 1000; i++) many.add_argument("option-" + std::to_string(i)).takes_value();
+    first.takes_value().short_name("F");
+    const char* many_argv[] = {"prog", "-F", "x", "--option-999", "y"};
+    many.parse(many_argv);
+    CHECK(many.ok());
+    CHECK(many.get("first").view() == "x");
+    CHECK(many.get("option-999").view() == "y");
+
+    // the parser resolves names and short names through the same table
+    argcpp::Parser parser;
+    parser.add_argument("verbose").short_name("v");
+    parser.add_argument("output").short_name("o").takes_value();
+    const char* argv[] = {"prog", "-v", "--output", "x"};
+    parser.parse(argv);
+    CHECK(parser.ok());
+    CHECK(parser.provided("verbose") && parser.provided("v"));
+    CHECK(parser.get("o").view() == "x");
+    const char* unknown[] = {"prog", "--outptu", "x"};
+    parser.parse(unknown);
+    CHECK(!parser.ok());
+    return argc_test::result();
+}
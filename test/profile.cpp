@@ -0,0 +1,61 @@
+// The counting operator new behind argcpp::profile(): aligned allocations are counted, and threads that allocate
+// while their thread_local objects are destroyed do not touch a dead profile.
+#define ARGCPP_INSTRUMENT 1
+#define ARGCPP_INSTRUMENT_ALLOCATIONS
+#include <single.hpp>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+
+namespace {
+    struct alignas(64) Wide {
+        char bytes[64];
+    };
+
+    // destroyed after the thread's profile when constructed before it, and allocates while being destroyed
+    struct Late {
+        ~Late() {
+            const std::unique_ptr<std::string> text = std::make_unique<std::string>(100, 'x');
+            const std::unique_ptr<Wide> wide = std::make_unique<Wide>();
+        }
+    };
+}
+
+int main() {
+    argcpp::Profile& profile = argcpp::profile();
+    const std::uint64_t allocations = profile.allocations;
+    const std::uint64_t bytes = profile.bytes;
+    const std::unique_ptr<Wide> wide = std::make_unique<Wide>();
+    CHECK(reinterpret_cast<std::uintptr_t>(wide.get()) % 64 == 0);
+    CHECK(profile.allocations == allocations + 1 && profile.bytes == bytes + sizeof(Wide));
+
+    // pmr blocks come through the aligned overload
+    void* block = std::pmr::new_delete_resource()->allocate(256, 32);
+    CHECK(profile.allocations == allocations + 2);
+    std::pmr::new_delete_resource()->deallocate(block, 256, 32);
+
+    argcpp::Parser parser;
+    parser.add_argument("input").position(1);
+    parser.add_argument("level").takes_value();
+    const argcpp::Schema& schema = parser.schema();
+    const char* argv[] = {"prog", "in", "--level", "3"};
+    CHECK(schema.parse(argv).ok());
+    CHECK(profile[argcpp::Phase::parse].calls == 1);
+
+    std::vector<std::uint64_t> counted(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < counted.size(); t++) {
+        threads.emplace_back([&counted, &schema, &argv, t] {
+            thread_local Late late;
+            static_cast<void>(late);
+            argcpp::Profile& mine = argcpp::profile();
+            for (int i = 0; i < 100; i++) static_cast<void>(schema.parse(argv));
+            counted[t] = mine[argcpp::Phase::parse].calls;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(counted == std::vector<std::uint64_t>(4, 100));
+    return argc_test::result();
+}
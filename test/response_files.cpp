@@ -0,0 +1,72 @@
+// @file arguments: quoting, nesting, empty files, and the errors for cycles and missing files.
+#include <single.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "check.hpp"
+
+namespace {
+    std::string write(const std::filesystem::path& dir, const char* name, const std::string& content) {
+        const auto path = dir / name;
+        std::ofstream(path) << content;
+        return "@" + path.string();
+    }
+
+    argcpp::Parser& declare(argcpp::Parser& parser) {
+        parser.response_files();
+        parser.add_argument("input").position(1);
+        parser.add_argument("output").takes_value();
+        parser.add_argument("verbose").short_name("v");
+        parser.add_argument("ids").takes_value().x_value_range(1, 8);
+        parser.add_argument("name").takes_value();
+        parser.add_argument("esc").takes_value();
+        parser.add_argument("last");
+        return parser;
+    }
+}
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / ("argc_response_files_" + std::to_string(std::rand()));
+    std::filesystem::create_directories(dir);
+    const std::string nested = write(dir, "nested.rsp", "  --ids 1,2,3\n\n");
+    const std::string outer = write(dir, "outer.rsp", "--output \"some file.txt\" -v\n" + nested + "\n--name='it''s' --esc a\\ b");
+    const std::string empty = write(dir, "empty.rsp", "");
+    const std::string loop = write(dir, "loop.rsp", "@" + (dir / "loop.rsp").string());
+
+    {
+        argcpp::Parser parser;
+        const char* argv[] = {"prog", "in", outer.c_str(), empty.c_str(), "--last"};
+        declare(parser).parse(argv);
+        CHECK(parser.ok());
+        CHECK(parser.get("input").view() == "in");
+        CHECK(parser.get("output").view() == "some file.txt");
+        CHECK(parser.get("name").view() == "its");
+        CHECK(parser.get("esc").view() == "a b");
+        CHECK(parser.get("ids").list().size() == 3);
+        CHECK(parser.provided("verbose") && parser.provided("last"));
+    }
+    {
+        // without response_files() the token is an ordinary positional
+        argcpp::Parser parser;
+        parser.add_argument("input").position(1);
+        const char* argv[] = {"prog", outer.c_str()};
+        parser.parse(argv);
+        CHECK(parser.ok());
+        CHECK(parser.get("input").view() == outer);
+    }
+    {
+        argcpp::Parser parser;
+        const char* argv[] = {"prog", "in", loop.c_str()};
+        declare(parser).parse(argv);
+        CHECK(!parser.ok());
+    }
+    {
+        argcpp::Parser parser;
+        const std::string missing = "@" + (dir / "missing.rsp").string();
+        const char* argv[] = {"prog", "in", missing.c_str()};
+        declare(parser).parse(argv);
+        CHECK(!parser.ok());
+    }
+    std::filesystem::remove_all(dir);
+    return argc_test::result();
+}
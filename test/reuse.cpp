@@ -0,0 +1,65 @@
+// One Parser and one ParseResult parse several command lines in turn: every parse starts from the defaults again.
+#include <single.hpp>
+#include <string>
+#include "check.hpp"
+
+int main() {
+    argcpp::Parser parser;
+    parser.add_argument("cmd").position(1);
+    parser.add_argument("ids").takes_value().x_value_range(1, -1);
+    parser.add_argument("level").takes_value().default_value(3);
+    parser.add_argument("force").short_name("f");
+    parser.add_argument("need").takes_value().required();
+    parser.add_argument("path").takes_value().default_value(std::string("/a/default/path/longer/than/sixteen"));
+    parser.add_argument("ports").takes_value().x_value_range(1, -1)
+        .default_value(std::vector<argcpp::Value>{std::string("a-port-name-longer-than-sixteen"), 80});
+
+    const char* full[] = {"x", "run", "--ids", "1,2,3,4,5,6", "--level=7", "-f", "--need", "y", "--path", "p",
+                          "--ports", "1,2,3"};
+    const char* minimal[] = {"x", "stop", "--need", "z"};
+    const char* invalid[] = {"x", "stop", "--bogus"};
+
+    for (int round = 0; round < 3; round++) {
+        parser.parse(full);
+        CHECK(parser.ok());
+        CHECK(parser.get("cmd").view() == "run");
+        CHECK(parser.get("ids").list().size() == 6);
+        CHECK(parser.get("level").get<int>().value == 7);
+        CHECK(parser.provided("f"));
+        CHECK(parser.get("path").view() == "p");
+        CHECK(parser.get("ports").list().size() == 3);
+
+        parser.parse(minimal);
+        CHECK(parser.ok());
+        CHECK(parser.get("cmd").view() == "stop");
+        CHECK(parser.get("ids").list().empty());
+        CHECK(!parser.get("ids").has_value());
+        CHECK(parser.get("level").get<int>().value == 3);
+        CHECK(!parser.provided("f"));
+        CHECK(parser.get("need").view() == "z");
+        CHECK(parser.get("path").view() == "/a/default/path/longer/than/sixteen");
+        CHECK(parser.result().source("path") == argcpp::Source::default_value);
+        const auto ports = parser.get("ports").list();
+        CHECK(ports.size() == 2 && ports[0].view() == "a-port-name-longer-than-sixteen" && ports[1].get<int>().value == 80);
+
+        parser.parse(invalid);
+        CHECK(!parser.ok());
+        CHECK(!parser.result().error().empty());
+    }
+
+    // a bare ParseResult, reset by hand between parses of the shared schema
+    const argcpp::Schema& schema = parser.schema();
+    argcpp::ParseResult result;
+    schema.parse(full, result);
+    CHECK(result.ok());
+    result.reset();
+    CHECK(result.ok() && result.error().empty());
+    CHECK(result.touched().empty());
+    CHECK(!result.provided("force"));
+    CHECK(result.get("path").view() == "/a/default/path/longer/than/sixteen");
+    CHECK(result.get("ids").list().empty());
+    schema.parse(minimal, result);
+    CHECK(result.ok());
+    CHECK(result.get("need").view() == "z");
+    return argc_test::result();
+}
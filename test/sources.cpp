@@ -0,0 +1,88 @@
+// Config files as a value source: only the requested section is read, values rank command line over environment over
+// config file over default as reported by source(), and a missing required file fails parses, not the schema.
+#include <single.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include "check.hpp"
+
+namespace {
+    void set_env(const char* name, const char* value) {
+#if defined(_WIN32)
+        _putenv_s(name, value);
+#else
+        setenv(name, value, 1);
+#endif
+    }
+}
+
+int main() {
+    using argcpp::Source;
+
+    const auto config = std::filesystem::temp_directory_path() / ("argc_sources_" + std::to_string(std::rand()) + ".ini");
+    std::ofstream(config) << "# shared\n[other]\nlevel = nope\n"
+                             "[app]\nlevel = \"info\"  \nport = 8080 # comment\nname = from-config\ntags = a,b\n"
+                             "[after]\nlevel = bad\n";
+    set_env("ARGC_TEST_PORT", "9000");
+    set_env("ARGC_TEST_NAME", "from-env");
+    set_env("ARGC_TEST_TOKEN", "secret");
+
+    argcpp::Parser parser;
+    parser.env_prefix("ARGC_TEST_");
+    parser.config_file(config.string(), "app").config_file((config.string() + ".missing"));
+    parser.add_argument("level").takes_value().allowed_values({"info", "debug"});
+    parser.add_argument("port").takes_value();
+    parser.add_argument("name").takes_value();
+    parser.add_argument("token").takes_value().required();
+    parser.add_argument("tags").takes_value().x_value_range(1, -1);
+    parser.add_argument("mode").takes_value().default_value(std::string("fast"));
+
+    const char* argv[] = {"prog", "--name", "from-cli"};
+    parser.parse(argv);
+    CHECK(parser.ok());
+    const argcpp::ParseResult& result = parser.result();
+    CHECK(parser.get("name").view() == "from-cli");
+    CHECK(result.source("name") == Source::command_line);
+    CHECK(parser.get("port").view() == "9000");
+    CHECK(result.source("port") == Source::environment);
+    CHECK(parser.get("token").view() == "secret");
+    CHECK(result.source("token") == Source::environment);
+    CHECK(parser.get("level").view() == "info");
+    CHECK(result.source("level") == Source::config_file);
+    CHECK(parser.get("tags").list().size() == 2);
+    CHECK(result.source("tags") == Source::config_file);
+    CHECK(parser.get("mode").view() == "fast");
+    CHECK(result.source("mode") == Source::default_value);
+
+    // the sources stay captured across parses, the command line still wins
+    const char* override_all[] = {"prog", "--port", "1", "--level", "debug"};
+    parser.parse(override_all);
+    CHECK(parser.ok());
+    CHECK(parser.get("port").view() == "1");
+    CHECK(parser.result().source("port") == Source::command_line);
+    CHECK(parser.get("level").view() == "debug");
+    CHECK(parser.get("name").view() == "from-env");
+    CHECK(parser.result().source("name") == Source::environment);
+
+    // a required file that is missing fails every parse through the result's error, it is not a schema error
+    const std::string missing = config.string() + ".missing";
+    argcpp::Parser strict;
+    strict.config_file(missing, "", true);
+    strict.add_argument("level").takes_value();
+    const char* bare[] = {"prog"};
+    bool thrown = false;
+    try {
+        for (int i = 0; i < 2; i++) {
+            strict.parse(bare);
+            CHECK(!strict.ok());
+            CHECK(strict.result().error() == "cannot read config file \"" + missing + "\"");
+        }
+        CHECK(!strict.schema().parse(bare).ok());
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    CHECK(!thrown);
+
+    std::filesystem::remove(config);
+    return argc_test::result();
+}
@@ -0,0 +1,75 @@
+// The vectorized for_each_byte, split and count agree with a plain byte loop, at every length and alignment.
+#include <single.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "check.hpp"
+
+namespace {
+    std::vector<std::size_t> scalar_positions(const std::string_view str, const char a, const char b) {
+        std::vector<std::size_t> out;
+        for (std::size_t i = 0; i < str.size(); i++) {
+            if (str[i] == a || str[i] == b) out.push_back(i);
+        }
+        return out;
+    }
+
+    std::vector<std::string_view> scalar_split(const std::string_view str, const char delimiter) {
+        std::vector<std::string_view> out;
+        std::size_t begin = 0;
+        for (const std::size_t pos : scalar_positions(str, delimiter, delimiter)) {
+            out.push_back(str.substr(begin, pos - begin));
+            begin = pos + 1;
+        }
+        out.push_back(str.substr(begin));
+        return out;
+    }
+
+    // constant evaluation always takes the scalar loop
+    constexpr std::size_t pieces(const std::string_view str, const char delimiter) {
+        std::size_t n = 0;
+        argcpp::helper::split(str, delimiter, [&n](std::string_view) { n++; });
+        return n;
+    }
+}
+
+int main() {
+    static_assert(pieces("a,b,,c", ',') == 4);
+    static_assert(pieces("", ',') == 1);
+
+    std::mt19937 rng(7);
+    const std::string alphabet = "abc,,;x";
+    std::string buffer(300, ' ');
+    for (std::size_t length = 0; length < 200; length++) {
+        for (std::size_t offset = 0; offset < 4; offset++) {
+            for (std::size_t i = 0; i < length; i++) buffer[offset + i] = alphabet[rng() % alphabet.size()];
+            const std::string_view str(buffer.data() + offset, length);
+
+            std::vector<std::size_t> positions;
+            argcpp::helper::for_each_byte(str, ',', ';', [&](const std::size_t pos) { positions.push_back(pos); });
+            CHECK(positions == scalar_positions(str, ',', ';'));
+
+            std::vector<std::string_view> split;
+            argcpp::helper::split(str, ',', [&](const std::string_view piece) { split.push_back(piece); });
+            CHECK(split == scalar_split(str, ','));
+
+            CHECK(argcpp::helper::count(str, ',') == scalar_positions(str, ',', ',').size());
+        }
+    }
+
+    // a long value, split in the parser, against the scalar pieces
+    std::string ids;
+    for (int i = 0; i < 10000; i++) ids += std::to_string(rng() % 100000) + ',';
+    ids.pop_back();
+    const std::vector<std::string_view> expected = scalar_split(ids, ',');
+    argcpp::Parser parser;
+    parser.add_argument("ids").takes_value().x_value_range(1, -1);
+    const char* argv[] = {"prog", "--ids", ids.c_str()};
+    parser.parse(argv);
+    CHECK(parser.ok());
+    const auto& list = parser.get("ids").list();
+    CHECK(list.size() == expected.size());
+    for (std::size_t i = 0; i < list.size() && i < expected.size(); i++) CHECK(list[i].view() == expected[i]);
+    return argc_test::result();
+}
@@ -0,0 +1,140 @@
+// Compile-time schemas: a large name table, lookups by every name, list values through get(), flags and errors.
+#include <single.hpp>
+#include <string>
+#include "check.hpp"
+
+// 70 arguments with an alias each, plus the arguments below: well past the size where a single seed stops working
+constexpr auto large = argcpp::make_static_schema([] {
+    return std::array{
+            argcpp::Static_Argument("option-00").takes_value().aliases("alias-00"),
+            argcpp::Static_Argument("option-01").takes_value().aliases("alias-01"),
+            argcpp::Static_Argument("option-02").takes_value().aliases("alias-02"),
+            argcpp::Static_Argument("option-03").takes_value().aliases("alias-03"),
+            argcpp::Static_Argument("option-04").takes_value().aliases("alias-04"),
+            argcpp::Static_Argument("option-05").takes_value().aliases("alias-05"),
+            argcpp::Static_Argument("option-06").takes_value().aliases("alias-06"),
+            argcpp::Static_Argument("option-07").takes_value().aliases("alias-07"),
+            argcpp::Static_Argument("option-08").takes_value().aliases("alias-08"),
+            argcpp::Static_Argument("option-09").takes_value().aliases("alias-09"),
+            argcpp::Static_Argument("option-10").takes_value().aliases("alias-10"),
+            argcpp::Static_Argument("option-11").takes_value().aliases("alias-11"),
+            argcpp::Static_Argument("option-12").takes_value().aliases("alias-12"),
+            argcpp::Static_Argument("option-13").takes_value().aliases("alias-13"),
+            argcpp::Static_Argument("option-14").takes_value().aliases("alias-14"),
+            argcpp::Static_Argument("option-15").takes_value().aliases("alias-15"),
+            argcpp::Static_Argument("option-16").takes_value().aliases("alias-16"),
+            argcpp::Static_Argument("option-17").takes_value().aliases("alias-17"),
+            argcpp::Static_Argument("option-18").takes_value().aliases("alias-18"),
+            argcpp::Static_Argument("option-19").takes_value().aliases("alias-19"),
+            argcpp::Static_Argument("option-20").takes_value().aliases("alias-20"),
+            argcpp::Static_Argument("option-21").takes_value().aliases("alias-21"),
+            argcpp::Static_Argument("option-22").takes_value().aliases("alias-22"),
+            argcpp::Static_Argument("option-23").takes_value().aliases("alias-23"),
+            argcpp::Static_Argument("option-24").takes_value().aliases("alias-24"),
+            argcpp::Static_Argument("option-25").takes_value().aliases("alias-25"),
+            argcpp::Static_Argument("option-26").takes_value().aliases("alias-26"),
+            argcpp::Static_Argument("option-27").takes_value().aliases("alias-27"),
+            argcpp::Static_Argument("option-28").takes_value().aliases("alias-28"),
+            argcpp::Static_Argument("option-29").takes_value().aliases("alias-29"),
+            argcpp::Static_Argument("option-30").takes_value().aliases("alias-30"),
+            argcpp::Static_Argument("option-31").takes_value().aliases("alias-31"),
+            argcpp::Static_Argument("option-32").takes_value().aliases("alias-32"),
+            argcpp::Static_Argument("option-33").takes_value().aliases("alias-33"),
+            argcpp::Static_Argument("option-34").takes_value().aliases("alias-34"),
+            argcpp::Static_Argument("option-35").takes_value().aliases("alias-35"),
+            argcpp::Static_Argument("option-36").takes_value().aliases("alias-36"),
+            argcpp::Static_Argument("option-37").takes_value().aliases("alias-37"),
+            argcpp::Static_Argument("option-38").takes_value().aliases("alias-38"),
+            argcpp::Static_Argument("option-39").takes_value().aliases("alias-39"),
+            argcpp::Static_Argument("option-40").takes_value().aliases("alias-40"),
+            argcpp::Static_Argument("option-41").takes_value().aliases("alias-41"),
+            argcpp::Static_Argument("option-42").takes_value().aliases("alias-42"),
+            argcpp::Static_Argument("option-43").takes_value().aliases("alias-43"),
+            argcpp::Static_Argument("option-44").takes_value().aliases("alias-44"),
+            argcpp::Static_Argument("option-45").takes_value().aliases("alias-45"),
+            argcpp::Static_Argument("option-46").takes_value().aliases("alias-46"),
+            argcpp::Static_Argument("option-47").takes_value().aliases("alias-47"),
+            argcpp::Static_Argument("option-48").takes_value().aliases("alias-48"),
+            argcpp::Static_Argument("option-49").takes_value().aliases("alias-49"),
+            argcpp::Static_Argument("option-50").takes_value().aliases("alias-50"),
+            argcpp::Static_Argument("option-51").takes_value().aliases("alias-51"),
+            argcpp::Static_Argument("option-52").takes_value().aliases("alias-52"),
+            argcpp::Static_Argument("option-53").takes_value().aliases("alias-53"),
+            argcpp::Static_Argument("option-54").takes_value().aliases("alias-54"),
+            argcpp::Static_Argument("option-55").takes_value().aliases("alias-55"),
+            argcpp::Static_Argument("option-56").takes_value().aliases("alias-56"),
+            argcpp::Static_Argument("option-57").takes_value().aliases("alias-57"),
+            argcpp::Static_Argument("option-58").takes_value().aliases("alias-58"),
+            argcpp::Static_Argument("option-59").takes_value().aliases("alias-59"),
+            argcpp::Static_Argument("option-60").takes_value().aliases("alias-60"),
+            argcpp::Static_Argument("option-61").takes_value().aliases("alias-61"),
+            argcpp::Static_Argument("option-62").takes_value().aliases("alias-62"),
+            argcpp::Static_Argument("option-63").takes_value().aliases("alias-63"),
+            argcpp::Static_Argument("option-64").takes_value().aliases("alias-64"),
+            argcpp::Static_Argument("option-65").takes_value().aliases("alias-65"),
+            argcpp::Static_Argument("option-66").takes_value().aliases("alias-66"),
+            argcpp::Static_Argument("option-67").takes_value().aliases("alias-67"),
+            argcpp::Static_Argument("option-68").takes_value().aliases("alias-68"),
+            argcpp::Static_Argument("option-69").takes_value().aliases("alias-69")
+    };
+});
+
+static_assert(large.size() == 70);
+static_assert(large.id("option-00") == 0 && large.id("alias-00") == 0);
+static_assert(large.id("option-69") == 69 && large.id("alias-69") == 69);
+static_assert(large.id("option-70") == large.npos && large.id("") == large.npos);
+
+constexpr auto small = argcpp::make_static_schema([] {
+    return std::array{
+        argcpp::Static_Argument("input").position(1),
+        argcpp::Static_Argument("verbose").flag().short_name("v"),
+        argcpp::Static_Argument("level").takes_value().allowed_values("fast|slow").default_value("fast"),
+        argcpp::Static_Argument("files").takes_value().x_value_range(1, -1),
+        argcpp::Static_Argument("tags").takes_value().x_value_range(0, -1),
+    };
+});
+
+int main() {
+    bool all = true;
+    for (int i = 0; i < 70; i++) {
+        const std::string suffix = (i < 10 ? "0" : "") + std::to_string(i);
+        all = all && large.id("option-" + suffix) == static_cast<std::uint32_t>(i);
+        all = all && large.id("alias-" + suffix) == static_cast<std::uint32_t>(i);
+    }
+    CHECK(all);
+    CHECK(large.id("option-7") == large.npos);
+
+    const char* long_line[] = {"prog", "--option-42", "x", "--alias-07=y", "-option-69", "z"};
+    const auto parsed = large.parse(long_line);
+    CHECK(parsed.ok());
+    CHECK(parsed.value(42) == "x" && parsed.value(7) == "y" && parsed.value(69) == "z");
+    CHECK(!parsed.provided(0));
+
+    const std::uint32_t input = small.id("input");
+    const std::uint32_t verbose = small.id("v");
+    const std::uint32_t level = small.id("level");
+    const std::uint32_t files = small.id("files");
+    const std::uint32_t tags = small.id("tags");
+
+    const char* args[] = {"prog", "in.txt", "-v", "--files", "a", "b", "c", "--tags"};
+    const auto result = small.parse(args);
+    CHECK(result.ok());
+    CHECK(result.get(input).view() == "in.txt");
+    CHECK(result.get(verbose).get<bool>().value);
+    CHECK(result.get(level).view() == "fast");
+    // a list argument gives its values, not a bare "provided" flag
+    const argcpp::Value list = result.get(files);
+    CHECK(list.list().size() == 3 && list.list()[0].view() == "a" && list.list()[2].view() == "c");
+    CHECK(result.values(files).size() == 3);
+    CHECK(result.get(tags).list().empty() && result.provided(tags));
+
+    const char* unknown[] = {"prog", "in.txt", "--nope"};
+    CHECK(small.parse(unknown).error() == "unknown argument \"--nope\"");
+    const char* bad_choice[] = {"prog", "in.txt", "--level", "medium"};
+    CHECK(!small.parse(bad_choice).ok());
+    const char* missing[] = {"prog"};
+    CHECK(!small.parse(missing).ok());
+
+    CHECK(small.help().find("--files <files>...") != std::string_view::npos);
+    return argc_test::result();
+}
@@ -0,0 +1,74 @@
+// Subcommand dispatch, nesting, and that only the dispatched subcommand's schema gets built.
+#include <single.hpp>
+#include <string>
+#include "check.hpp"
+
+static int built = 0;
+
+namespace {
+    void declare(argcpp::Parser& parser) {
+        parser.add_argument("verbose").short_name("v");
+        for (int i = 0; i < 40; i++) {
+            parser.add_subcommand("cmd" + std::to_string(i), [](argcpp::Parser& command) {
+                built++;
+                command.add_argument("force").short_name("f");
+                command.add_argument("mode").takes_value().allowed_values({"a", "b"});
+            });
+        }
+        parser.add_subcommand("remote", [](argcpp::Parser& remote) {
+            built++;
+            remote.add_subcommand("add", [](argcpp::Parser& add) {
+                built++;
+                add.add_argument("name").position(1);
+            });
+        });
+    }
+}
+
+int main() {
+    {
+        argcpp::Parser parser;
+        declare(parser);
+        const char* argv[] = {"prog", "-v", "cmd7", "-f", "--mode", "b"};
+        parser.parse(argv);
+        CHECK(parser.ok());
+        CHECK(parser.provided("verbose"));
+        CHECK(parser.subcommand_name() == "cmd7");
+        CHECK(built == 1);
+        argcpp::Parser* command = parser.subcommand();
+        CHECK(command != nullptr);
+        if (command) {
+            CHECK(command->provided("force"));
+            CHECK(command->get("mode").view() == "b");
+            CHECK(command->subcommand() == nullptr);
+        }
+    }
+    {
+        built = 0;
+        argcpp::Parser parser;
+        declare(parser);
+        const char* argv[] = {"prog", "remote", "add", "origin"};
+        parser.parse(argv);
+        CHECK(parser.ok());
+        CHECK(!parser.provided("verbose"));
+        CHECK(parser.subcommand_name() == "remote");
+        CHECK(built == 2);
+        argcpp::Parser* remote = parser.subcommand();
+        CHECK(remote && remote->subcommand_name() == "add");
+        if (remote && remote->subcommand()) CHECK(remote->subcommand()->get("name").view() == "origin");
+    }
+    {
+        argcpp::Parser parser;
+        declare(parser);
+        const char* none[] = {"prog", "-v"};
+        parser.parse(none);
+        CHECK(parser.ok());
+        CHECK(parser.subcommand() == nullptr);
+        CHECK(parser.subcommand_name().empty());
+
+        const char* invalid[] = {"prog", "cmd3", "--mode", "c"};
+        parser.parse(invalid);
+        CHECK(!parser.ok());
+    }
+    return argc_test::result();
+}
@@ -0,0 +1,51 @@
+// "did you mean" suggestions: the bit-parallel edit distance, its limit and pattern length bounds, and the ranked
+// names an unknown option reports.
+#include <single.hpp>
+#include <string>
+#include "check.hpp"
+
+namespace {
+    std::string error_for(const argcpp::Schema& schema, const std::string& token) {
+        const char* argv[] = {"prog", token.c_str()};
+        return std::string(schema.parse(argv).error());
+    }
+}
+
+int main() {
+    using argcpp::helper::Edit_Distance;
+    constexpr std::size_t npos = Edit_Distance::npos;
+
+    CHECK(Edit_Distance("kitten")("sitting", 3) == 3);
+    CHECK(Edit_Distance("kitten")("sitting", 2) == npos);
+    CHECK(Edit_Distance("verbose")("verbose", 0) == 0);
+    CHECK(Edit_Distance("verbose")("verbos", 1) == 1);
+    CHECK(Edit_Distance("verbose")("v", 3) == npos);
+    CHECK(Edit_Distance("")("ab", 2) == 2);
+    CHECK(Edit_Distance("")("abc", 2) == npos);
+
+    // 64 characters is the widest pattern; a longer one reports no match at all, however short the text
+    const std::string widest(64, 'a');
+    CHECK(Edit_Distance(widest)(widest, 0) == 0);
+    CHECK(Edit_Distance(widest)(std::string(63, 'a') + 'b', 1) == 1);
+    const std::string too_long(65, 'a');
+    CHECK(Edit_Distance(too_long)(too_long, 3) == npos);
+    CHECK(Edit_Distance(too_long)("", 3) == npos);
+    CHECK(Edit_Distance(too_long)("v", 3) == npos);
+
+    argcpp::Parser parser;
+    parser.add_argument("verbose").short_name("v");
+    parser.add_argument("version");
+    parser.add_argument("output").aliases({"out"});
+    parser.add_argument("hidden-one").hidden();
+    const argcpp::Schema& schema = parser.schema();
+
+    CHECK(error_for(schema, "--verbos") == "unknown argument \"--verbos\" (did you mean \"--verbose\"?)");
+    CHECK(error_for(schema, "--outptu") == "unknown argument \"--outptu\" (did you mean \"--output\"?)");
+    CHECK(error_for(schema, "--versio") == "unknown argument \"--versio\" (did you mean \"--version\"?)");
+    CHECK(error_for(schema, "--outpt") == "unknown argument \"--outpt\" (did you mean \"--output\" or \"--out\"?)");
+    CHECK(error_for(schema, "--xyz") == "unknown argument \"--xyz\"");
+    CHECK(error_for(schema, "--hidden-on") == "unknown argument \"--hidden-on\"");
+    const std::string long_typo = "--" + std::string(70, 'q');
+    CHECK(error_for(schema, long_typo) == "unknown argument \"" + long_typo + "\"");
+    return argc_test::result();
+}
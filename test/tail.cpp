@@ -0,0 +1,91 @@
+// The variadic positional: a view over argv when it comes straight from the command line, views into response file
+// buffers otherwise, and allowed values checked on every element either way.
+#include <single.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+namespace {
+    std::vector<std::string> collect(const argcpp::Tail& tail) {
+        std::vector<std::string> out;
+        for (const std::string_view value : tail) out.emplace_back(value);
+        return out;
+    }
+}
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / ("argc_tail_" + std::to_string(std::rand()));
+    std::filesystem::create_directories(dir);
+    const std::string list = "@" + (dir / "list.rsp").string();
+    std::ofstream(dir / "list.rsp") << "c.txt d.txt\n";
+    const std::string bad = "@" + (dir / "bad.rsp").string();
+    std::ofstream(dir / "bad.rsp") << "slow medium\n";
+
+    argcpp::Parser parser;
+    parser.response_files();
+    parser.add_argument("input").position(1);
+    parser.add_argument("files").position(2).variadic();
+    parser.add_argument("verbose").short_name("v");
+    const argcpp::Schema& schema = parser.schema();
+
+    {
+        const char* argv[] = {"prog", "in", "a.txt", "b.txt", "c.txt"};
+        const argcpp::ParseResult result = schema.parse(argv);
+        CHECK(result.ok());
+        const argcpp::Tail tail = result.tail("files");
+        CHECK(tail.size() == 3 && tail[0] == "a.txt" && tail[2] == "c.txt");
+        // zero-copy: the tail is the argv entries themselves
+        CHECK(tail.argv().data() == argv + 2);
+        CHECK(tail.strings() == std::vector<std::string>({"a.txt", "b.txt", "c.txt"}));
+        CHECK(result.tail("input").empty());
+    }
+    {
+        // the tail stops at the first option
+        const char* argv[] = {"prog", "in", "a.txt", "b.txt", "-v"};
+        const argcpp::ParseResult result = schema.parse(argv);
+        CHECK(result.ok() && result.provided("verbose"));
+        CHECK(result.tail("files").argv().size() == 2);
+    }
+    {
+        // a response file in the tail switches to collected views, argv entries before it included
+        const char* argv[] = {"prog", "in", "a.txt", "b.txt", list.c_str()};
+        const argcpp::ParseResult result = schema.parse(argv);
+        CHECK(result.ok());
+        const argcpp::Tail tail = result.tail("files");
+        CHECK(tail.argv().empty());
+        CHECK(collect(tail) == std::vector<std::string>({"a.txt", "b.txt", "c.txt", "d.txt"}));
+    }
+    {
+        // a response file before the tail supplies its first values
+        const char* argv[] = {"prog", "in", list.c_str(), "e.txt"};
+        const argcpp::ParseResult result = schema.parse(argv);
+        CHECK(result.ok());
+        CHECK(collect(result.tail("files")) == std::vector<std::string>({"c.txt", "d.txt", "e.txt"}));
+    }
+    {
+        const char* argv[] = {"prog", "in"};
+        CHECK(!schema.parse(argv).ok());
+    }
+
+    argcpp::Parser checked;
+    checked.response_files();
+    checked.add_argument("modes").allowed_values({"fast", "slow"}).position(1).variadic();
+    const argcpp::Schema& modes = checked.schema();
+    {
+        const char* argv[] = {"prog", "fast", "slow", "fast"};
+        const argcpp::ParseResult result = modes.parse(argv);
+        CHECK(result.ok() && result.tail("modes").size() == 3);
+    }
+    {
+        const char* argv[] = {"prog", "fast", "medium"};
+        CHECK(modes.parse(argv).error() == "invalid value \"medium\" for argument \"modes\", expected one of fast, slow");
+    }
+    {
+        const char* argv[] = {"prog", "fast", bad.c_str()};
+        CHECK(!modes.parse(argv).ok());
+    }
+    std::filesystem::remove_all(dir);
+    return argc_test::result();
+}
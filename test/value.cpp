@@ -0,0 +1,73 @@
+// Value layout and ownership: which alternative each constructor picks, and that copies own their text and lists
+// while views and moves do not copy.
+#include <single.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "check.hpp"
+
+int main() {
+    using Kind = argcpp::Value::Kind;
+    static_assert(sizeof(argcpp::Value) <= 32);
+
+    CHECK(argcpp::Value().kind() == Kind::empty);
+    CHECK(!argcpp::Value().has_value());
+    CHECK(argcpp::Value(true).kind() == Kind::boolean);
+    CHECK(argcpp::Value(7).kind() == Kind::integer);
+    CHECK(argcpp::Value(0.5).kind() == Kind::floating);
+
+    // text up to 16 characters is stored inline, longer text on the heap, string_views are not copied at all
+    const std::string sixteen(16, 's');
+    const std::string seventeen(17, 'l');
+    const argcpp::Value small(sixteen);
+    const argcpp::Value owned(seventeen);
+    CHECK(small.kind() == Kind::small && small.view() == sixteen);
+    CHECK(owned.kind() == Kind::string && owned.view() == seventeen);
+    CHECK(owned.view().data() != seventeen.data());
+    const argcpp::Value view{std::string_view(seventeen)};
+    CHECK(view.kind() == Kind::view && view.view().data() == seventeen.data());
+
+    // copies are deep, moves take the buffer and leave the source empty
+    const argcpp::Value copy = owned;
+    CHECK(copy.kind() == Kind::string && copy.view() == seventeen && copy.view().data() != owned.view().data());
+    argcpp::Value source(seventeen);
+    const char* buffer = source.view().data();
+    argcpp::Value moved = std::move(source);
+    CHECK(moved.view().data() == buffer);
+    CHECK(source.kind() == Kind::empty);
+    moved = small;
+    CHECK(moved.kind() == Kind::small && moved.view() == sixteen);
+
+    // lists own their elements; pushing a view keeps it a view
+    argcpp::Value list;
+    list.push_back(std::string_view(seventeen));
+    list.push_back(std::string("owned text longer than sixteen"));
+    list.push_back(argcpp::Value(3));
+    CHECK(list.kind() == Kind::list && list.list().size() == 3);
+    CHECK(list.list()[0].kind() == Kind::view && list.list()[0].view().data() == seventeen.data());
+    CHECK(list.list()[1].kind() == Kind::string);
+    CHECK(list.list()[2].get<int>().value == 3);
+    for (int i = 0; i < 100; i++) list.push_back(argcpp::Value(i));
+    CHECK(list.list().size() == 103 && list.list()[102].get<int>().value == 99);
+
+    argcpp::Value list_copy = list;
+    CHECK(list_copy.list().size() == 103);
+    CHECK(list_copy.list().data() != list.list().data());
+    CHECK(list_copy.list()[1].view().data() != list.list()[1].view().data());
+    list.clear();
+    CHECK(list.kind() == Kind::list && !list.has_value());
+    CHECK(list_copy.list().size() == 103);
+
+    const std::vector<argcpp::Value> elements{argcpp::Value(1), argcpp::Value(seventeen)};
+    const argcpp::Value from_vector(elements);
+    CHECK(from_vector.list().size() == 2 && from_vector.list()[1].view() == seventeen);
+    CHECK(static_cast<std::vector<argcpp::Value>>(from_vector).size() == 2);
+    CHECK(static_cast<std::string>(owned) == seventeen);
+
+    // a value that is not a list has no elements, reset() empties any alternative
+    CHECK(owned.list().empty());
+    argcpp::Value reset = copy;
+    reset.reset();
+    CHECK(reset.kind() == Kind::empty && reset.view().empty());
+    return argc_test::result();
+}